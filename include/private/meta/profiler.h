@@ -59,6 +59,25 @@ namespace lsp
             static constexpr float DURATION_DFL         = 10.0f;
             static constexpr float DURATION_STEP        = 0.5f;
 
+            static constexpr float LONG_DURATION_MIN    = 60.0f;
+            static constexpr float LONG_DURATION_MAX    = 1200.0f;
+            static constexpr float LONG_DURATION_DFL    = 120.0f;
+            static constexpr float LONG_DURATION_STEP   = 1.0f;
+
+            enum chirp_quality_selector_t
+            {
+                SC_QUALITY_DRAFT,
+                SC_QUALITY_STANDARD,
+                SC_QUALITY_REFERENCE,
+
+                SC_QUALITY_DFL = SC_QUALITY_REFERENCE
+            };
+
+            static constexpr float MTR_PREP_MIN         = 0.0f;         /* Min preprocessing time [ms] */
+            static constexpr float MTR_PREP_MAX         = 60000.0f;     /* Max preprocessing time [ms] */
+            static constexpr float MTR_PREP_DFL         = 0.0f;
+            static constexpr float MTR_PREP_STEP        = 1.0f;
+
             static constexpr float MTR_T_MIN            = 0.0f;
             static constexpr float MTR_T_MAX            = 60.0f;
             static constexpr float MTR_T_DFL            = 0.0f;
@@ -111,7 +130,25 @@ namespace lsp
                 SC_SVMODE_DFL = SC_SVMODE_AUTO
             };
 
+            enum archive_mode_selector_t
+            {
+                SC_ARCHIVE_OFF,
+                SC_ARCHIVE_INDEXED,
+                SC_ARCHIVE_COMPRESSED,
+
+                SC_ARCHIVE_DFL = SC_ARCHIVE_OFF
+            };
+
+            static constexpr size_t EXPORT_RATES        = 5;            /* Number of extra sample rates for exporting the IR */
+
             static constexpr size_t RESULT_MESH_SIZE    = 512;
+
+            static constexpr size_t ETC_MESH_SIZE       = 512;          /* Number of points of Energy Time Curve */
+            static constexpr float ETC_FLOOR            = GAIN_AMP_M_96_DB; /* The lowest level displayed by Energy Time Curve */
+
+            static constexpr size_t CSD_SLICES          = 64;           /* Number of time slices of Cumulative Spectral Decay */
+            static constexpr size_t CSD_MESH_SIZE       = 256;          /* Number of frequency points of Cumulative Spectral Decay */
+            static constexpr float CSD_RANGE            = 60.0f;        /* Dynamic range of Cumulative Spectral Decay [dB] */
         };
 
         extern const meta::plugin_t profiler_mono;
@@ -23,15 +23,31 @@
 #define PRIVATE_PLUGINS_PROFILER_H_
 
 #include <lsp-plug.in/plug-fw/plug.h>
+#include <lsp-plug.in/plug-fw/core/IDBuffer.h>
 #include <lsp-plug.in/dsp-units/ctl/Bypass.h>
 #include <lsp-plug.in/dsp-units/sampling/Sample.h>
 #include <lsp-plug.in/dsp-units/util/LatencyDetector.h>
 #include <lsp-plug.in/dsp-units/util/Oscillator.h>
 #include <lsp-plug.in/dsp-units/util/ResponseTaker.h>
 #include <lsp-plug.in/dsp-units/util/SyncChirpProcessor.h>
-
+#include <lsp-plug.in/ipc/Semaphore.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/runtime/system.h>
 
 #include <private/meta/profiler.h>
+#include <private/plugins/profiler/DecayAnalyzer.h>
+#include <private/plugins/profiler/IndexedArchive.h>
+#include <private/plugins/profiler/IRWriter.h>
+#include <private/plugins/profiler/LongSweep.h>
+#include <private/plugins/profiler/MinMaxPyramid.h>
+#include <private/plugins/profiler/PartitionTuner.h>
+#include <private/plugins/profiler/PolyphaseResampler.h>
+#include <private/plugins/profiler/RingBuffer.h>
+#include <private/plugins/profiler/ScratchArena.h>
+#include <private/plugins/profiler/TripleBuffer.h>
+#include <private/plugins/profiler/WorkerPool.h>
+
+#include <atomic>
 
 namespace lsp
 {
@@ -40,11 +56,92 @@ namespace lsp
         class profiler: public plug::Module
         {
             protected:
+                static constexpr size_t SAVE_TARGETS    = meta::profiler_metadata::SC_SVMOD_NLINEAR + 1;   // Number of saving modes
+                static constexpr size_t WAV_TARGETS     = meta::profiler_metadata::SC_SVMOD_NLINEAR;       // Number of saving modes producing WAV files
+                static constexpr size_t RESULT_SLOTS    = 2;                                                // Number of buffers for measurement results
+                static constexpr size_t EXPORT_RATES    = meta::profiler_metadata::EXPORT_RATES;           // Number of extra sample rates for exporting
+                static constexpr size_t CHANNELS_MAX    = 2;                                                // Maximum number of channels
+
+                // Measurement result kept for saving, the IR is not changed while the slot is being saved
+                typedef struct result_t
+                {
+                    size_t                  nOrigin;                // Position of the time origin in the IR [samples]
+                    ssize_t                 nOffset;                // IR offset applied by the post-processing [samples]
+                    float                   fReverbTime;            // Maximum reverberation time among channels [s]
+                    float                   fIntgLimit;             // Maximum integration limit among channels [s]
+                    bool                    bValid;                 // The slot holds the post-processed result
+                } result_t;
+
+            protected:
+                // Class to handle allocation of heavy DSP objects on the first use of the plugin
+                class Preparer: public ipc::ITask
+                {
+                    private:
+                        profiler *pCore;
+                        size_t    nSampleRate;                  // Sample rate the objects are prepared for
+
+                    public:
+                        explicit Preparer(profiler *base);
+                        virtual ~Preparer();
+
+                    public:
+                        inline size_t sample_rate() const { return nSampleRate; }
+
+                        virtual status_t run();
+                };
+
+                // Task starting threads of the worker pool outside of the audio thread
+                class PoolStarter: public ipc::ITask
+                {
+                    private:
+                        profiler *pCore;
+
+                    public:
+                        explicit PoolStarter(profiler *base);
+                        virtual ~PoolStarter();
+
+                    public:
+                        virtual status_t run();
+                };
+
+                // Task measuring the costs of convolution partitions when the plugin is idle
+                class Tuner: public ipc::ITask
+                {
+                    private:
+                        PartitionTuner  sTuner;                         // Chooser of the partition size
+
+                    public:
+                        explicit Tuner();
+                        virtual ~Tuner();
+
+                    public:
+                        inline const PartitionTuner *tuner() const { return &sTuner; }
+
+                        virtual status_t run();
+                };
+
                 // Class to handle profiling time series generation task
                 class PreProcessor: public ipc::ITask
                 {
                     private:
-                        profiler *pCore;
+                        // Shape of the capture the response taker has been configured for
+                        typedef struct shape_t
+                        {
+                            const float *pChirp;                        // Data of the chirp
+                            size_t      nChirp;                         // Length of the chirp [samples]
+                            size_t      nLatency;                       // Latency of the chain [samples]
+                            size_t      nSampleRate;                    // Sample rate
+                            bool        bValid;                         // The shape has been applied
+                        } shape_t;
+
+                    private:
+                        profiler   *pCore;
+                        shape_t     vShapes[CHANNELS_MAX];
+                        float       fTime;                              // Time of the last run [ms]
+
+                    public:
+                        void        invalidate();
+                        inline float time() const       { return fTime; }
 
                     public:
                         explicit PreProcessor(profiler *base);
@@ -54,17 +151,37 @@ namespace lsp
                         virtual status_t run();
                 };
 
-                // Task to handle generation of the convolution result
+                // Task to handle generation of the convolution result from the captured response,
+                // from the previously saved LSPC file or from the response recorded to the audio file
                 class Convolver: public ipc::ITask
                 {
+                    public:
+                        enum source_t
+                        {
+                            SRC_CAPTURE,                                // Response captured by the plugin
+                            SRC_LSPC,                                   // Convolution result stored in the LSPC file
+                            SRC_RESPONSE                                // Response recorded to the audio file
+                        };
+
                     private:
-                        profiler *pCore;
+                        profiler       *pCore;
+                        source_t        enSource;                       // Source of the convolution result
+                        char            sFile[PATH_MAX];                // File to load the data from
+                        ScratchArena    sArena;                         // Buffer for streaming the response file
+
+                    protected:
+                        status_t load_lspc();
+                        status_t load_response();
+                        size_t   partition_size();
 
                     public:
                         explicit Convolver(profiler *base);
                         virtual ~Convolver();
 
                     public:
+                        void set_source(source_t source, const char *fname);
+                        inline source_t source() const { return enSource; }
+
                         virtual status_t run();
                 };
 
@@ -75,6 +192,10 @@ namespace lsp
                         profiler           *pCore;
                         ssize_t             nIROffset;
                         dspu::scp_rtcalc_t  enAlgo;
+                        bool                bAutoOffset;
+
+                    protected:
+                        ssize_t detect_ir_onset(const float *ir, size_t length) const;
 
                     public:
                         explicit PostProcessor(profiler *base);
@@ -84,18 +205,42 @@ namespace lsp
                         void set_ir_offset(ssize_t ir_offset);
                         inline ssize_t get_ir_offset() const { return nIROffset; }
 
+                        void set_auto_offset(bool enable);
+
                         void set_rt_algo(dspu::scp_rtcalc_t algo);
 
                         virtual status_t run();
                 };
 
-                // Class to handle saving of the convolution result
+                // Class to handle saving of the convolution result to WAV files
                 class Saver: public ipc::ITask
                 {
                     private:
                         profiler       *pCore;
+                        const result_t *pResult;                        // Result being saved
+                        std::atomic<bool>   bCopy;                      // Copy the convolution result before saving
+                        size_t          nOrigin;                        // Position of the time origin in the IR
                         ssize_t         nIROffset;
-                        char            sFile[PATH_MAX]; // The name of file for saving
+                        float           fReverbTime;                    // Maximum reverberation time [s]
+                        float           fIntgLimit;                     // Maximum integration limit [s]
+                        size_t          nTargets;                       // Set of saving targets, one bit per saving mode
+                        size_t          nPrimary;                       // Saving mode which uses the file name as is
+                        size_t          nIndex;                         // Index of the saving for the file name template
+                        size_t          nRate;                          // Sample rate of saved files, 0 for the native sample rate
+                        size_t          nResamplerRate;                 // Source sample rate the resampler is initialized for
+                        float           fProgress;                      // Progress of the saving [%]
+                        system::time_t  sTime;                          // Time of the saving for the file name template
+                        bool            bSplit;                         // Save each channel to the separate WAV file
+                        char            sFile[PATH_MAX];                // The name of file for saving, may be a template
+                        char            sPath[PATH_MAX];                // The name of file of the current target
+                        IRWriter        vWriters[WAV_TARGETS * CHANNELS_MAX]; // Writers for each WAV target and channel
+                        PolyphaseResampler  sResampler;                 // Resampler for exporting at non-native sample rate
+                        ScratchArena    sArena;                         // Buffer for interleaving and resampling
+
+                    protected:
+                        status_t save_result();
+                        status_t save_linear_convolution(const size_t *counts, bool resample);
+                        void expand_template(char *dst, size_t index, const system::time_t *time, ssize_t channel) const;
 
                     public:
                         explicit Saver(profiler *base);
@@ -103,11 +248,182 @@ namespace lsp
 
                     public:
                         void set_file_name(const char *fname);
-                        void set_ir_offset(ssize_t ir_offset);
+                        void set_result(const result_t *result);
+                        void set_targets(size_t targets, size_t primary);
+                        void set_stamp(size_t index, const system::time_t *time);
+                        void set_rate(size_t rate);
+                        void set_copy(bool copy);
+                        inline const result_t *get_result() const { return pResult; }
+                        inline bool copying() const { return bCopy.load(std::memory_order_acquire); }
+                        inline size_t get_rate() const { return nRate; }
+                        inline float get_progress() const { return fProgress; }
                         inline ssize_t get_ir_offset() const { return nIROffset; }
+                        inline size_t get_targets() const { return nTargets; }
 
                         bool is_file_set() const;
 
+                        /**
+                         * Get the name of the file for the saving target: the file name for the
+                         * primary target, the file name with the target suffix for other targets.
+                         * The fields {index}, {date}, {time} and {channel} of the file name are
+                         * replaced with actual values, the sample rate suffix is added for
+                         * savers exporting at non-native sample rate.
+                         * @param dst buffer of PATH_MAX characters to store the name
+                         * @param target saving mode
+                         * @param channel channel saved to the file, negative for all channels
+                         */
+                        void get_target_path(char *dst, size_t target, ssize_t channel) const;
+
+                        /**
+                         * Get the name of the capture file: the file name with the extension replaced by the suffix
+                         * @param dst buffer of PATH_MAX characters to store the name
+                         * @param index index of the saving for the file name template
+                         * @param time time for the file name template
+                         * @param suffix suffix of the capture file with the extension
+                         */
+                        void get_capture_path(char *dst, size_t index, const system::time_t *time, const char *suffix) const;
+
+                        virtual status_t run();
+                };
+
+                // Class to handle saving of all the measured information to LSPC file,
+                // runs in parallel with the Saver
+                class LSPCSaver: public ipc::ITask
+                {
+                    private:
+                        profiler       *pCore;
+                        size_t          nArchive;                       // Mode of the indexed archive
+                        char            sPath[PATH_MAX];                // The name of file for saving
+                        IndexedArchive  sArchive;                       // Indexed archive of the measurement
+
+                    protected:
+                        status_t write_archive();
+
+                    public:
+                        explicit LSPCSaver(profiler *base);
+                        virtual ~LSPCSaver();
+
+                    public:
+                        void set_archive(size_t mode);
+
+                        virtual status_t run();
+                };
+
+                // Class to handle export of the test chirp for offline measurements
+                class ChirpSaver: public ipc::ITask
+                {
+                    private:
+                        profiler       *pCore;
+                        char            sPath[PATH_MAX];                // The name of file for saving
+                        IRWriter        sWriter;
+
+                    public:
+                        explicit ChirpSaver(profiler *base);
+                        virtual ~ChirpSaver();
+
+                    public:
+                        void set_file_name(const char *fname);
+
+                        virtual status_t run();
+                };
+
+                // Class to handle the sweep longer than the measurement allows: exports the chirp
+                // or deconvolves the response recorded with it, both stream over the files
+                class LongSweeper: public ipc::ITask
+                {
+                    public:
+                        enum op_t
+                        {
+                            OP_EXPORT,                                  // Export the chirp
+                            OP_DECONVOLVE,                              // Deconvolve the recorded response
+                            OP_MEASURE                                  // Deconvolve the response captured by the plugin
+                        };
+
+                    private:
+                        op_t            enOp;                           // Operation to perform
+                        char            sPath[PATH_MAX];                // The name of file to export or deconvolve
+                        LongSweep       sSweep;
+
+                    public:
+                        explicit LongSweeper();
+                        virtual ~LongSweeper();
+
+                    public:
+                        status_t configure(op_t op, const char *fname, size_t sample_rate, float duration, float amplitude);
+                        void set_file_name(const char *fname);
+                        inline op_t op() const { return enOp; }
+
+                        virtual status_t run();
+                };
+
+                // Class to handle archiving of the raw capture, drains the capture ring to the WAV file
+                // Dedicated thread that drains the raw capture ring to the file, it does not
+                // depend on the executor queue, so other jobs can not delay the draining
+                class CaptureArchiver: public ipc::Thread
+                {
+                    public:
+                        enum archive_state_t
+                        {
+                            AS_IDLE,                                    // Nothing to archive
+                            AS_RECORDING,                               // The ring is drained to the file
+                            AS_FINISH,                                  // The ring is drained, then the file is closed
+                            AS_DONE                                     // The file is closed, the result code is available
+                        };
+
+                        static constexpr size_t DRAIN_PERIOD    = 20;   // Period of draining the ring [ms]
+
+                    private:
+                        profiler       *pCore;
+                        size_t          nIndex;                         // Index of the saving for the file name template
+                        system::time_t  sTime;                          // Time of the capture for the file name template
+                        const char     *pSuffix;                        // Suffix of the capture file
+                        uatomic_t       nState;                         // Archive state, see archive_state_t
+                        status_t        nCode;                          // Result of archiving, valid in AS_DONE state
+                        bool            bStarted;                       // The thread has been started
+                        char            sPath[PATH_MAX];                // The name of file for saving
+                        IRWriter        sWriter;
+                        ipc::Semaphore  sWakeup;                        // Wakes up the thread on shutdown
+                        float          *vBuffer;                        // Buffer for interleaved frames
+                        uint8_t        *pData;
+
+                    protected:
+                        void            drain();
+
+                    public:
+                        explicit CaptureArchiver(profiler *base);
+                        virtual ~CaptureArchiver();
+
+                    public:
+                        status_t        launch();
+                        void            stop();
+
+                        // Called from the audio thread
+                        bool            begin(size_t index, const system::time_t *time, const char *suffix);
+                        void            finish();
+                        bool            done(status_t *code);
+
+                        inline bool     started() const         { return bStarted; }
+                        inline bool     idle()                  { return atomic_load(&nState) == AS_IDLE; }
+                        inline const char *path() const         { return sPath; }
+
+                        virtual status_t run();
+                };
+
+                // Class to handle decay analysis of the convolution result, one tile per run
+                class Analyzer: public ipc::ITask
+                {
+                    private:
+                        profiler       *pCore;
+                        size_t          nTile;
+
+                    public:
+                        explicit Analyzer(profiler *base);
+                        virtual ~Analyzer();
+
+                    public:
+                        void set_tile(size_t tile);
+                        inline size_t get_tile() const { return nTile; }
+
                         virtual status_t run();
                 };
 
@@ -122,7 +438,9 @@ namespace lsp
                     RECORDING,                      // Realtime: recording response
                     CONVOLVING,                     // Offline: Convolver task
                     POSTPROCESSING,                 // Offline: PostProcessor task
-                    SAVING                          // Offline: Saver task
+                    SAVING,                         // Offline: Saver task, runs in background and is reported only in idle state
+                    PREPARING,                      // Offline: Preparer task, allocates DSP objects on the first use
+                    LONGSWEEP                       // Realtime: playing the long sweep, the response is spilled to disk
                 };
 
                 enum triggers_t
@@ -137,7 +455,9 @@ namespace lsp
                     T_LAT_TRIGGER_STATE     = 1 << 6, // Latency measurement trigger state
                     T_LIN_TRIGGER           = 1 << 7, // Linear measurement trigger is pressed
                     T_LIN_TRIGGER_STATE     = 1 << 8, // Linear measurement trigger state
-                    T_FEEDBACK              = 1 << 9  // feedback break switch is pressed on
+                    T_FEEDBACK              = 1 << 9, // feedback break switch is pressed on
+                    T_LONG_TRIGGER          = 1 << 10, // Long sweep measurement trigger was pressed
+                    T_LONG_TRIGGER_STATE    = 1 << 11 // Long sweep measurement trigger state
                 };
 
                 typedef struct postproc_t
@@ -149,6 +469,12 @@ namespace lsp
                     bool                    bRTAccuray;             // If true, dynamic range and bacjground noise are optimal for RT accuracy.
                 } posproc_t;
 
+                typedef struct snapshot_t
+                {
+                    postproc_t              sPostProc;              // Post-processing info
+                    float                  *vPlot;                  // Plot data, RESULT_MESH_SIZE points
+                } snapshot_t;
+
                 typedef struct channel_t
                 {
                     dspu::Bypass            sBypass;
@@ -156,11 +482,20 @@ namespace lsp
                     dspu::ResponseTaker     sResponseTaker;         // To take response of system after Synch Chirp stimulation
 
                     size_t                  nLatency;               // Store latency value
+                    size_t                  nTakerLatency;          // Latency applied to the response taker
                     bool                    bLatencyMeasured;       // If true, a latency measurement was performed
                     bool                    bLCycleComplete;        // If true, a latency measurement cycle was finished
                     bool                    bRCycleComplete;        // If true, a chirp response recording cycle was finished.
 
                     postproc_t              sPostProc;              // Holds IR postproc info.
+                    MinMaxPyramid           sPyramid;               // Min/max pyramid of the convolution result for plotting
+                    dspu::Sample            sFileResponse;          // Response loaded from the audio file for offline measurement
+                    snapshot_t              vSnapshots[TripleBuffer::SLOTS]; // Post-processing results passed to the audio thread
+                    snapshot_t              vDisplay[TripleBuffer::SLOTS];   // Post-processing results passed to the inline display
+                    bool                    bPlotPending;           // The plot of the front snapshot is not committed to the mesh yet
+                    float                   fCSDReference;          // Reference magnitude of Cumulative Spectral Decay
+                    float                  *vETC;                   // Energy Time Curve
+                    bool                    bETCPending;            // Energy Time Curve is not committed to the mesh yet
 
                     float                  *vBuffer;                // Auxiliary processing buffer
 
@@ -177,6 +512,8 @@ namespace lsp
                     plug::IPort            *pILScreen;              // Little screen displaying IL (integration limit) value
                     plug::IPort            *pRScreen;               // Little screen displaying R (RT regression line correlation coefficient) value
                     plug::IPort            *pResultMesh;            // Mesh for result plot
+                    plug::IPort            *pETCMesh;               // Mesh for Energy Time Curve
+                    plug::IPort            *pCSD;                   // Frame buffer for Cumulative Spectral Decay
                 } channel_t;
 
                 typedef struct response_t
@@ -198,36 +535,82 @@ namespace lsp
 
                 response_t                  sResponseData;
                 save_t                      sSaveData;
+                result_t                    vResults[RESULT_SLOTS]; // Measurement results, one is saved while another one is measured
+                size_t                      nResultFront;           // Slot of the last post-processed result
+                size_t                      nResultBack;            // Slot of the result being measured
+                bool                        bResultPending;         // The back slot holds new convolution result waiting for post-processing
+                size_t                      nSaveIndex;             // Index of the next saving for the file name template
+                size_t                      nRatesPending;          // Sample rate savers waiting for the copy of the result, one bit per rate
+                dspu::Sample                sSavedIR;               // Copy of the saved window of the convolution result
+                size_t                      nSavedFirst;            // Position of the copy in the convolution result
+                size_t                      nSavedLength;           // Length of the convolution result the copy is made of
+                bool                        bAutoSavePending;       // The front result should be saved automatically
+                bool                        bChirpLoaded;           // Chirp settings were replaced by the loaded LSPC file
+                bool                        bChirpPending;          // Chirp settings are deferred until the LSPC file is written
                 state_t                     nState;                 // Object State
+                TripleBuffer                sResults;               // Snapshots of post-processing results
+                TripleBuffer                sDisplay;               // Snapshots of post-processing results for the inline display
 
                 dspu::Oscillator            sCalOscillator;         // For calibration
 
                 dspu::SyncChirpProcessor    sSyncChirpProcessor;    // To handle Synch Chirp profiling signal and related operations
 
                 ipc::IExecutor             *pExecutor;              // Executor Service
+                WorkerPool                  sWorkerPool;            // Worker pool of the plugin
+                PoolStarter                *pPoolStarter;           // Task starting the worker pool
+                Tuner                      *pTuner;                 // Task measuring the costs of convolution partitions
+                bool                        bWorkerPool;            // Tasks should be submitted to the worker pool
+                bool                        bPoolStarted;           // Threads of the worker pool are started
+                Preparer                   *pPreparer;              // Preparer Task
+                bool                        bPrepared;              // DSP objects are allocated by the Preparer Task
                 PreProcessor               *pPreProcessor;          // Pre Processor Task
                 Convolver                  *pConvolver;             // Convolver Task
                 PostProcessor              *pPostProcessor;         // Post Processor Task
                 Saver                      *pSaver;                 // Saver Task
+                Saver                      *vRateSavers[EXPORT_RATES]; // Saver Tasks for exporting at extra sample rates
+                LSPCSaver                  *pLSPCSaver;             // LSPC Saver Task
+                ChirpSaver                 *pChirpSaver;            // Chirp export Task
+                CaptureArchiver            *pCaptureArchiver;       // Raw capture archiving thread
+                LongSweeper                *pLongSweeper;           // Long sweep Task
+                RingBuffer                  sCaptureRing;           // Ring buffer passing the raw capture to the archiving thread
+                bool                        bCaptureArchiving;      // Raw capture is being archived
+                size_t                      nCaptureOverrun;        // Number of frames of the raw capture dropped due to overrun
+                LongSweep                   sLongSweep;             // Long sweep played in realtime
+                wsize_t                     nLongOffset;            // Number of frames of the realtime long sweep played
+                wsize_t                     nLongLength;            // Length of the realtime long sweep with the tail [samples]
+                size_t                      nLongOverrun;           // Number of frames of the long sweep response dropped due to overrun
+                bool                        bLongCapture;           // The response of the realtime long sweep is being spilled to disk
+                Analyzer                   *pAnalyzer;              // Decay Analyzer Task
+
+                DecayAnalyzer               sDecayAnalyzer;         // Decay analysis engine
+                size_t                      nAnalysisTile;          // Current tile of decay analysis
+                float                      *vCSDRows;               // Rows of Cumulative Spectral Decay computed by the tile
 
                 size_t                      nSampleRate;            // Sample Rate
+                size_t                      nIROrigin;              // Position of the time origin in the convolution result [samples]
                 float                       fLtAmplitude;           // Amplitude factor for Latency Detection chirp
                 ssize_t                     nWaitCounter;           // Count the samples for wait state
                 bool                        bDoLatencyOnly;         // If true, only latency is measured
 
                 float                       fScpDurationPrevious;   // Store Sync Chirp Duration Setting between calls to update_settings()
+                size_t                      nChirpQuality;          // Quality of the chirp synthesis
                 bool                        bIRMeasured;            // If true, an IR measurement was performed and post processed
                 size_t                      nSaveMode;              // Hold save mode enumeration index
+                size_t                      nSaveTargets;           // Set of saving targets, one bit per save mode
+                size_t                      nExportRates;           // Set of extra sample rates for exporting, one bit per rate
 
                 size_t                      nTriggers;              // Set of triggers controlled by triggers_t
 
                 float                      *vTempBuffer;            // Additional auxiliary buffer for processing
                 float                      *vDisplayAbscissa;       // Buffer for display. Abscissa data
-                float                      *vDisplayOrdinate;       // Buffer for display. Ordinate data
+                core::IDBuffer             *pIDisplay;              // Inline display buffer: cached geometry of the result plots
+                size_t                      nIDisplayWidth;         // Width of the cached inline display geometry
+                size_t                      nIDisplayHeight;        // Height of the cached inline display geometry
                 uint8_t                    *pData;
 
                 plug::IPort                *pBypass;
                 plug::IPort                *pStateLEDs;             // State LEDs
+                plug::IPort                *pWorkerPool;            // Switch to run tasks on the worker pool of the plugin
 
                 plug::IPort                *pCalFrequency;          // Calibration wave frequency
                 plug::IPort                *pCalAmplitude;          // Calibration wave amplitude
@@ -242,27 +625,76 @@ namespace lsp
 
                 plug::IPort                *pDuration;              // Profiling Sync Chirp Duration
                 plug::IPort                *pActualDuration;        // Actual Sync Chirp Duration after optimisation
+                plug::IPort                *pChirpQuality;          // Quality of the chirp synthesis
+                plug::IPort                *pPreprocTime;           // Time spent for the last preprocessing
                 plug::IPort                *pLinTrigger;            // Trigger for linear system measurement
 
                 plug::IPort                *pIROffset;              // Offset of the measured convolution result, for plot and export
+                plug::IPort                *pIRAutoOffset;          // Switch to detect the offset from the onset of the direct sound
+                plug::IPort                *pIROffsetMeter;         // Offset actually applied for plot and export
                 plug::IPort                *pRTAlgoSelector;        // Selector for RT calculation algorithm
                 plug::IPort                *pPostTrigger;           // Trigger for post processing
 
                 plug::IPort                *pSaveModeSelector;      // Selector for Save Mode
+                plug::IPort                *vSaveTargets[SAVE_TARGETS]; // Switches for extra saving targets
+                plug::IPort                *vExportRates[EXPORT_RATES]; // Switches for extra sample rates of exported files
                 plug::IPort                *pIRFileName;            // File name for IR file
                 plug::IPort                *pIRSaveCmd;             // Command to save IR file
                 plug::IPort                *pIRSaveStatus;          // IR file saving status
                 plug::IPort                *pIRSavePercent;         // IR file saving percent
+                plug::IPort                *pAutoSave;              // Switch to save the result after each measurement
+                plug::IPort                *pIRLoadFile;            // File name of LSPC file to load
+                plug::IPort                *pIRLoadStatus;          // LSPC file loading status
+                plug::IPort                *pArchiveMode;           // Mode of the indexed archive written with LSPC file
+                plug::IPort                *pChirpFile;             // File name for the exported chirp
+                plug::IPort                *pChirpCmd;              // Command to export the chirp
+                plug::IPort                *pChirpStatus;           // Chirp export status
+                plug::IPort                *pResponseFile;          // File name of the recorded response for offline measurement
+                plug::IPort                *pResponseStatus;        // Recorded response loading status
+                plug::IPort                *pLongDuration;          // Duration of the long sweep
+                plug::IPort                *pLongChirpFile;         // File name for the exported long sweep chirp
+                plug::IPort                *pLongChirpCmd;          // Command to export the long sweep chirp
+                plug::IPort                *pLongChirpStatus;       // Long sweep chirp export status
+                plug::IPort                *pLongResponseFile;      // File name of the response recorded with the long sweep
+                plug::IPort                *pLongResponseStatus;    // Long sweep deconvolution status
+                plug::IPort                *pLongMeasureCmd;        // Command to measure with the long sweep in realtime
+                plug::IPort                *pLongMeasureStatus;     // Realtime long sweep measurement status
+                plug::IPort                *pCaptureSwitch;         // Switch to archive the raw capture
+                plug::IPort                *pCaptureStatus;         // Raw capture archiving status
 
             protected:
                 static dspu::scp_rtcalc_t   get_rt_algorithm(size_t algorithm);
+                static status_t             store_result(dspu::Sample *dst, const dspu::Sample *src, size_t first, size_t count);
 
             protected:
+                bool                        submit_task(ipc::ITask *task);
+                void                        update_worker_pool();
+                void                        update_tuner();
                 void                        update_pre_processing_info();
                 void                        commit_state_change();
+                bool                        prepare_on_demand();
                 void                        reset_tasks();
-                bool                        update_post_processing_info();
+                void                        update_post_processing_info();
+                void                        commit_result();
+                void                        configure_chirp();
+                void                        restore_chirp();
+                void                        commit_chirp();
+                void                        start_loading(plug::IPort *file, plug::IPort *status, Convolver::source_t source);
+                void                        update_chirp_export();
+                void                        update_long_sweep();
+                void                        start_long_measurement();
+                void                        update_long_measurement();
+                void                        start_capture_archive();
+                void                        update_capture_archive();
+                bool                        chirp_exporting();
+                bool                        can_save();
+                void                        start_saving();
+                void                        update_saving();
+                bool                        lspc_saving();
+                bool                        rate_saving();
                 void                        update_saving_info();
+                void                        start_analysis();
+                void                        update_analysis();
                 void                        process_buffer(size_t to_do);
                 void                        do_destroy();
 
@@ -278,6 +710,7 @@ namespace lsp
                 virtual void        update_sample_rate(long sr) override;
 
                 virtual void        process(size_t samples) override;
+                virtual bool        inline_display(plug::ICanvas *cv, size_t width, size_t height) override;
                 virtual void        dump(dspu::IStateDumper *v) const override;
         };
     } /* namespace plugins */
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_PLUGINS_PROFILER_DECAYANALYZER_H_
+#define PRIVATE_PLUGINS_PROFILER_DECAYANALYZER_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Decay analysis of the impulse response: Energy Time Curve computed
+         * from the Hilbert envelope and slices of Cumulative Spectral Decay
+         * computed from sliding windowed FFTs
+         */
+        class DecayAnalyzer
+        {
+            private:
+                size_t          nRank;          // FFT rank
+                float          *vRe;            // Real part of FFT buffer
+                float          *vIm;            // Imaginary part of FFT buffer
+                float          *vWindow;        // Tail window for spectral decay
+                uint8_t        *pData;
+
+            public:
+                explicit DecayAnalyzer();
+                DecayAnalyzer(const DecayAnalyzer &) = delete;
+                DecayAnalyzer(DecayAnalyzer &&) = delete;
+                ~DecayAnalyzer();
+
+                DecayAnalyzer & operator = (const DecayAnalyzer &) = delete;
+                DecayAnalyzer & operator = (DecayAnalyzer &&) = delete;
+
+                /**
+                 * Initialize analyzer
+                 * @param rank FFT rank
+                 * @return status of operation
+                 */
+                status_t        init(size_t rank);
+
+                void            destroy();
+
+            public:
+                inline size_t   fft_size() const        { return size_t(1) << nRank; }
+
+                /**
+                 * Compute Energy Time Curve: peak of the Hilbert envelope for each point
+                 * normalized to the peak of the whole range
+                 * @param dst destination buffer to store the curve, amplitude gain
+                 * @param points number of points
+                 * @param src impulse response
+                 * @param count number of samples of impulse response
+                 * @param floor minimum value of the curve
+                 */
+                void            energy_time_curve(float *dst, size_t points, const float *src, size_t count, float floor);
+
+                /**
+                 * Compute magnitude spectrum of the impulse response segment starting at src,
+                 * the segment is truncated at the start and tapered at the end
+                 * @param src start of the segment
+                 * @param count number of samples available after start of the segment
+                 * @return maximum magnitude of the spectrum
+                 */
+                float           spectrum(const float *src, size_t count);
+
+                /**
+                 * Map the last computed spectrum to the logarithmic frequency scale
+                 * @param dst destination buffer to store values in range [0..1]
+                 * @param cols number of columns
+                 * @param sample_rate sample rate of the impulse response
+                 * @param f_min lower frequency
+                 * @param f_max upper frequency
+                 * @param ref reference magnitude (0 dB)
+                 * @param range dynamic range in decibels mapped to [0..1]
+                 */
+                void            map_spectrum(float *dst, size_t cols, size_t sample_rate, float f_min, float f_max, float ref, float range);
+
+                void            dump(dspu::IStateDumper *v) const;
+        };
+
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_PROFILER_DECAYANALYZER_H_ */
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_PROFILER_IRWRITER_H_
+#define PRIVATE_PLUGINS_PROFILER_IRWRITER_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+#include <lsp-plug.in/dsp-units/sampling/Sample.h>
+#include <lsp-plug.in/mm/OutAudioFileStream.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Streaming writer of the impulse response to the audio file. The data is
+         * interleaved and written in chunks of fixed size, so the extra memory does
+         * not depend on the length of the impulse response.
+         */
+        class IRWriter
+        {
+            public:
+                static constexpr size_t CHUNK_SIZE  = 0x1000;   // Number of frames written at once
+
+            private:
+                mm::OutAudioFileStream  sOut;           // Output stream
+                size_t                  nChannels;      // Number of channels
+                wsize_t                 nWritten;       // Number of frames written
+                bool                    bOpened;        // Stream is opened
+                float                  *vBuffer;        // Buffer to interleave one chunk, allocated on demand
+                uint8_t                *pData;
+
+            public:
+                explicit IRWriter();
+                IRWriter(const IRWriter &) = delete;
+                IRWriter(IRWriter &&) = delete;
+                ~IRWriter();
+
+                IRWriter & operator = (const IRWriter &) = delete;
+                IRWriter & operator = (IRWriter &&) = delete;
+
+            public:
+                /**
+                 * Open the file for writing
+                 * @param path path to the file
+                 * @param channels number of channels
+                 * @param sample_rate sample rate
+                 * @param frames expected number of frames
+                 * @return status of operation
+                 */
+                status_t        open(const char *path, size_t channels, size_t sample_rate, size_t frames);
+
+                /**
+                 * Append the range of the sample to the file. The range outside of
+                 * the sample is written as silence.
+                 * @param src sample to write, should have the same number of channels
+                 * @param first the first frame of the range, may be negative
+                 * @param count number of frames to write
+                 * @return status of operation
+                 */
+                status_t        write(const dspu::Sample *src, ssize_t first, size_t count);
+
+                /**
+                 * Append already interleaved frames to the file
+                 * @param src interleaved frames
+                 * @param count number of frames to write
+                 * @return status of operation
+                 */
+                status_t        write_interleaved(const float *src, size_t count);
+
+                /**
+                 * Close the file and release the buffer
+                 * @return status of operation
+                 */
+                status_t        close();
+
+                inline bool     opened() const          { return bOpened; }
+                inline wsize_t  written() const         { return nWritten; }
+
+                void            dump(dspu::IStateDumper *v) const;
+
+            public:
+                /**
+                 * Interleave the range of the sample, the range outside of the sample is filled with silence
+                 * @param dst destination buffer of count * src->channels() elements
+                 * @param src source sample
+                 * @param first the first frame of the range, may be negative
+                 * @param count number of frames
+                 */
+                static void     interleave(float *dst, const dspu::Sample *src, ssize_t first, size_t count);
+        };
+
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_PROFILER_IRWRITER_H_ */
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_PROFILER_INDEXEDARCHIVE_H_
+#define PRIVATE_PLUGINS_PROFILER_INDEXEDARCHIVE_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+#include <lsp-plug.in/io/NativeFile.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Indexed archive of the measurement. The file consists of the header, the sequence of
+         * chunks and the index of chunks at the end of the file. Each index entry holds the type,
+         * channel and harmonic of the chunk together with its position in the file, so any single
+         * chunk can be read without reading the rest of the file. The payload of each chunk is
+         * a sequence of 32-bit words which is optionally packed with the lossless codec.
+         * The header and the index are stored in little-endian byte order.
+         */
+        class IndexedArchive
+        {
+            public:
+                static constexpr uint32_t MAGIC         = 0x5850534c;   // 'LSPX' in little-endian byte order
+                static constexpr uint32_t VERSION       = 1;
+                static constexpr size_t ENTRIES_MAX     = 64;
+
+                enum chunk_type_t
+                {
+                    CT_META,                    // Common metadata of the measurement, meta_t
+                    CT_CHANNEL,                 // Per-channel metadata, channel_meta_t
+                    CT_CAPTURE,                 // Captured response of the channel, float samples
+                    CT_IR                       // Segment of the convolution result for the harmonic, float samples
+                };
+
+                enum codec_t
+                {
+                    CODEC_RAW,                  // Words are stored as is
+                    CODEC_XOR_PACK              // Each word is XOR'ed with the previous one, leading zero bytes are dropped
+                };
+
+                typedef struct header_t
+                {
+                    uint32_t        magic;      // MAGIC
+                    uint32_t        version;    // VERSION
+                    uint32_t        entries;    // Number of index entries
+                    uint32_t        flags;      // Reserved, zero
+                    uint64_t        index;      // Offset of the index in the file
+                } header_t;
+
+                typedef struct entry_t
+                {
+                    uint32_t        type;       // Chunk type, chunk_type_t
+                    uint16_t        channel;    // Channel of the chunk
+                    uint16_t        harmonic;   // Harmonic of the IR segment, 1 for the linear response
+                    uint32_t        codec;      // Codec of the payload, codec_t
+                    uint32_t        flags;      // Reserved, zero
+                    int64_t         position;   // IR segments: position of the first sample relative to the IR time origin,
+                                                // captures: position of the response start in the capture
+                    uint64_t        offset;     // Offset of the payload in the file
+                    uint64_t        size;       // Size of the payload in the file
+                    uint64_t        length;     // Size of the decoded payload
+                } entry_t;
+
+                typedef struct meta_t
+                {
+                    uint32_t        sample_rate;    // Sample rate [Hz]
+                    uint32_t        channels;       // Number of channels
+                    uint32_t        harmonics;      // Number of harmonics
+                    int32_t         ir_offset;      // IR time offset applied for export [samples]
+                    double          initial_freq;   // Initial frequency of the chirp [Hz]
+                    double          final_freq;     // Final frequency of the chirp [Hz]
+                    double          duration;       // Duration of the chirp [s]
+                    double          alpha;          // Chirp alpha parameter
+                    double          gamma;          // Chirp gamma parameter
+                } meta_t;
+
+                typedef struct channel_meta_t
+                {
+                    uint32_t        latency;        // Measured latency [samples]
+                    uint32_t        rt_accurate;    // Non-zero if the background noise allowed accurate RT measurement
+                    float           reverb_time;    // Reverberation time [s]
+                    float           correlation;    // Correlation coefficient of the RT regression line
+                    float           intg_limit;     // Integration limit [s]
+                    float           reserved;       // Reserved, zero
+                } channel_meta_t;
+
+            private:
+                io::NativeFile      sFile;
+                header_t            sHeader;
+                entry_t             vEntries[ENTRIES_MAX];
+                bool                bOpened;
+                bool                bWriting;
+                bool                bCompress;
+                uint8_t            *vBuffer;        // Buffer for packed payload
+                size_t              nCapacity;      // Capacity of the buffer
+
+            protected:
+                status_t            reserve(size_t bytes);
+                status_t            write_fully(const void *data, size_t bytes);
+                status_t            read_fully(void *data, size_t bytes);
+                static void         swap_header(header_t *h);
+                static void         swap_entry(entry_t *e);
+                static size_t       pack(uint8_t *dst, const uint32_t *src, size_t count);
+                static bool         unpack(uint32_t *dst, size_t count, const uint8_t *src, size_t size);
+
+            public:
+                explicit IndexedArchive();
+                IndexedArchive(const IndexedArchive &) = delete;
+                IndexedArchive(IndexedArchive &&) = delete;
+                ~IndexedArchive();
+
+                IndexedArchive & operator = (const IndexedArchive &) = delete;
+                IndexedArchive & operator = (IndexedArchive &&) = delete;
+
+            public:
+                /**
+                 * Create new archive for writing
+                 * @param path path to the file
+                 * @param compress pack the payload of chunks with the lossless codec
+                 * @return status of operation
+                 */
+                status_t            create(const char *path, bool compress);
+
+                /**
+                 * Append chunk to the archive
+                 * @param type chunk type
+                 * @param channel channel of the chunk
+                 * @param harmonic harmonic of the chunk
+                 * @param position position of the first sample relative to the IR time origin for IR segments,
+                 *   position of the response start for captures
+                 * @param data payload of the chunk
+                 * @param count number of 32-bit words in the payload
+                 * @return status of operation
+                 */
+                status_t            write(chunk_type_t type, size_t channel, size_t harmonic, ssize_t position,
+                                        const void *data, size_t count);
+
+                /**
+                 * Open existing archive for reading, only the header and the index are read
+                 * @param path path to the file
+                 * @return status of operation
+                 */
+                status_t            open(const char *path);
+
+                /**
+                 * Find the chunk in the index
+                 * @param type chunk type
+                 * @param channel channel of the chunk
+                 * @param harmonic harmonic of the chunk, ignored for all chunks except CT_IR
+                 * @return pointer to the index entry or NULL if there is no such chunk
+                 */
+                const entry_t      *find(chunk_type_t type, size_t channel, size_t harmonic) const;
+
+                /**
+                 * Read the decoded payload of the chunk
+                 * @param entry index entry of the chunk
+                 * @param dst destination buffer of entry->length bytes
+                 * @return status of operation
+                 */
+                status_t            read(const entry_t *entry, void *dst);
+
+                /**
+                 * Close the archive, the index is written to the file if it was created for writing
+                 * @return status of operation
+                 */
+                status_t            close();
+
+                inline bool         opened() const          { return bOpened; }
+                inline size_t       entries() const         { return sHeader.entries; }
+                inline const entry_t *entry(size_t index) const { return (index < sHeader.entries) ? &vEntries[index] : NULL; }
+
+                void                dump(dspu::IStateDumper *v) const;
+        };
+
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_PROFILER_INDEXEDARCHIVE_H_ */
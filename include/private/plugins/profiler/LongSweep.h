@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_PROFILER_LONGSWEEP_H_
+#define PRIVATE_PLUGINS_PROFILER_LONGSWEEP_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Exponential sine sweep which is never kept in memory as a whole. The sweep and its inverse
+         * filter are computed analytically for any range of samples, the chirp is exported to the file
+         * chunk by chunk, and the response recorded with it is deconvolved by the partitioned convolution
+         * that streams over the response file. Only the window of the linear impulse response is kept in
+         * memory, so the duration of the sweep is limited by the disk, not by the memory.
+         */
+        class LongSweep
+        {
+            public:
+                static constexpr size_t PARTITION_RANK  = 16;                       // Partition of the convolution is 2^PARTITION_RANK samples
+                static constexpr size_t PARTITION       = 1 << PARTITION_RANK;      // Size of the partition
+                static constexpr float  FADE_IN         = 0.500f;                   // Duration of the chirp fade-in [s]
+                static constexpr float  FADE_OUT        = 0.020f;                   // Duration of the chirp fade-out [s]
+                static constexpr float  TAIL_MAX        = 10.0f;                    // Maximum length of the deconvolved impulse response [s]
+
+            private:
+                size_t          nSampleRate;        // Sample rate
+                wsize_t         nLength;            // Length of the chirp [samples]
+                double          fInitialFreq;       // Initial frequency [Hz]
+                double          fFinalFreq;         // Final frequency [Hz]
+                double          fRate;              // Sweep rate L [samples]: the frequency grows e times each L samples
+                float           fAmplitude;         // Amplitude of the chirp
+                float           fNorm;              // Normalizing factor of the inverse filter
+
+            protected:
+                double          phase(wsize_t n) const;
+
+            public:
+                explicit LongSweep();
+                LongSweep(const LongSweep &) = delete;
+                LongSweep(LongSweep &&) = delete;
+                ~LongSweep();
+
+                LongSweep & operator = (const LongSweep &) = delete;
+                LongSweep & operator = (LongSweep &&) = delete;
+
+            public:
+                /**
+                 * Set up the sweep
+                 * @param sample_rate sample rate
+                 * @param initial_freq initial frequency of the sweep
+                 * @param final_freq final frequency of the sweep, below the Nyquist frequency
+                 * @param duration duration of the sweep in seconds
+                 * @param amplitude amplitude of the sweep
+                 * @return status of operation
+                 */
+                status_t        init(size_t sample_rate, float initial_freq, float final_freq, float duration, float amplitude);
+
+                inline wsize_t  length() const          { return nLength; }
+                inline size_t   sample_rate() const     { return nSampleRate; }
+
+                /**
+                 * Compute the range of chirp samples, the fades are applied to the chirp
+                 * @param dst destination buffer
+                 * @param offset first sample of the range
+                 * @param count number of samples, samples beyond the chirp are zero
+                 */
+                void            chirp(float *dst, wsize_t offset, size_t count) const;
+
+                /**
+                 * Compute the range of inverse filter samples. The convolution of the chirp with the
+                 * inverse filter is the unit impulse at the last sample of the chirp
+                 * @param dst destination buffer
+                 * @param offset first sample of the range
+                 * @param count number of samples, samples beyond the filter are zero
+                 */
+                void            inverse(float *dst, wsize_t offset, size_t count) const;
+
+                /**
+                 * Export the chirp to the audio file chunk by chunk
+                 * @param path path to the file
+                 * @return status of operation
+                 */
+                status_t        export_chirp(const char *path) const;
+
+                /**
+                 * Deconvolve the response recorded to the audio file and save the linear impulse response
+                 * starting from the time origin. The response file is read once, block by block.
+                 * @param response path to the file with recorded response
+                 * @param ir path to the file to store the impulse response
+                 * @return status of operation
+                 */
+                status_t        deconvolve(const char *response, const char *ir) const;
+
+                void            dump(dspu::IStateDumper *v) const;
+        };
+
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_PROFILER_LONGSWEEP_H_ */
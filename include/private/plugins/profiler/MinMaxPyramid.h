@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_PROFILER_MINMAXPYRAMID_H_
+#define PRIVATE_PLUGINS_PROFILER_MINMAXPYRAMID_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Min/max pyramid over a long signal. Each level holds the minimum and maximum
+         * of the (1 << SHIFT) cells of the level below, level 0 is the source signal itself.
+         * Any range of the source can be reduced to its min/max in O(log(N)) time, so
+         * the plot of any time window can be extracted without touching the source signal
+         * and without losing narrow peaks.
+         */
+        class MinMaxPyramid
+        {
+            public:
+                static constexpr size_t SHIFT       = 3;
+                static constexpr size_t FACTOR      = 1 << SHIFT;
+                static constexpr size_t MASK        = FACTOR - 1;
+                static constexpr size_t LEVELS_MAX  = 16;
+
+            private:
+                const float    *pSrc;                   // Source signal (level 0), not owned
+                size_t          nLength;                // Length of the source signal
+                size_t          nLevels;                // Number of levels above the source signal
+                size_t          nCapacity;              // Capacity of the allocated data
+                float           fAbsMax;                // Absolute maximum of the whole signal
+                float          *vMin[LEVELS_MAX];       // Minimums of each level, vMin[0] is unused
+                float          *vMax[LEVELS_MAX];       // Maximums of each level, vMax[0] is unused
+                size_t          vLength[LEVELS_MAX];    // Length of each level
+                float          *vData;                  // Aligned storage of all levels
+                uint8_t        *pData;
+
+            protected:
+                void            reduce(size_t level, size_t index, float *min, float *max) const;
+
+            public:
+                explicit MinMaxPyramid();
+                MinMaxPyramid(const MinMaxPyramid &) = delete;
+                MinMaxPyramid(MinMaxPyramid &&) = delete;
+                ~MinMaxPyramid();
+
+                MinMaxPyramid & operator = (const MinMaxPyramid &) = delete;
+                MinMaxPyramid & operator = (MinMaxPyramid &&) = delete;
+
+                void            destroy();
+
+            public:
+                /**
+                 * Build the pyramid. The source data is not copied and should stay
+                 * valid until the pyramid is cleared or re-built.
+                 * @param src source signal
+                 * @param count number of samples in the source signal
+                 * @return status of operation
+                 */
+                status_t        build(const float *src, size_t count);
+
+                /**
+                 * Forget the source signal, the allocated memory is kept for re-use
+                 */
+                void            clear();
+
+                inline bool     is_empty() const        { return pSrc == NULL; }
+                inline size_t   length() const          { return nLength; }
+                inline size_t   levels() const          { return nLevels; }
+                inline float    abs_max() const         { return fAbsMax; }
+
+                /**
+                 * Get minimum and maximum of the source signal in the range [first, last)
+                 * @param first first sample of the range
+                 * @param last the sample after the last sample of the range
+                 * @param min pointer to store the minimum
+                 * @param max pointer to store the maximum
+                 * @return false if the range does not intersect the signal
+                 */
+                bool            get_minmax(ssize_t first, ssize_t last, float *min, float *max) const;
+
+                /**
+                 * Resample the range of the source signal to the specified number of points,
+                 * each point is the peak value (the one with the largest magnitude) of the
+                 * related part of the range, parts outside of the signal are zero
+                 * @param dst destination buffer to store points
+                 * @param first the first sample of the range, may be negative
+                 * @param count number of samples in the range
+                 * @param points number of points to store
+                 * @param normalize normalize the output by the absolute maximum of the signal
+                 */
+                void            get_peaks(float *dst, ssize_t first, size_t count, size_t points, bool normalize) const;
+
+                void            dump(dspu::IStateDumper *v) const;
+        };
+
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_PROFILER_MINMAXPYRAMID_H_ */
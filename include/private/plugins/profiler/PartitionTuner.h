@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_PLUGINS_PROFILER_PARTITIONTUNER_H_
+#define PRIVATE_PLUGINS_PROFILER_PARTITIONTUNER_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Chooser of the partition size for the deconvolution. The cost of the fast convolution
+         * of one block and of the spectrum of one block is measured once for each candidate
+         * partition on the current machine, the measurement ('wisdom') can be stored to the file
+         * and loaded back. The partition is chosen by the estimated cost of the partitioned
+         * convolution for the actual lengths of the response and the inverse filter, so the cache
+         * effects of large partitions and the padding of short signals are both accounted.
+         * The costs come from the stand-in benchmark of dsp::fastconv_parse() and dsp::fastconv_apply()
+         * on synthetic data, not from the convolution of SyncChirpProcessor itself, so they rank the
+         * partitions rather than predict the time of the deconvolution.
+         * The wisdom file is stored in little-endian byte order.
+         */
+        class PartitionTuner
+        {
+            public:
+                static constexpr uint32_t MAGIC         = 0x5750534c;   // 'LSPW' in little-endian byte order
+                static constexpr uint32_t VERSION       = 1;
+                static constexpr size_t RANK_MIN        = 10;           // Minimum partition is 2^RANK_MIN samples
+                static constexpr size_t RANK_MAX        = 16;           // Maximum partition is 2^RANK_MAX samples
+                static constexpr size_t RANKS           = RANK_MAX - RANK_MIN + 1;
+                static constexpr size_t BENCH_BLOCKS    = 4;            // Number of filter blocks in the benchmark working set
+                static constexpr size_t BENCH_TIME      = 10000000;     // Minimum time of measurement of each operation [ns]
+
+            private:
+                typedef struct wisdom_t
+                {
+                    uint32_t        magic;                  // Magic number
+                    uint32_t        version;                // Version of the file
+                    uint32_t        rank_min;               // Rank of the first partition
+                    uint32_t        ranks;                  // Number of partitions
+                    uint32_t        parse[RANKS];           // Cost of the spectrum of one block [ns]
+                    uint32_t        apply[RANKS];           // Cost of the convolution of one block pair [ns]
+                } wisdom_t;
+
+            private:
+                uint32_t        vParse[RANKS];              // Cost of the spectrum of one block [ns]
+                uint32_t        vApply[RANKS];              // Cost of the convolution of one block pair [ns]
+                bool            bReady;                     // Costs are measured or loaded
+
+            protected:
+                static status_t measure(size_t rank, uint32_t *parse, uint32_t *apply);
+
+            public:
+                explicit PartitionTuner();
+                PartitionTuner(const PartitionTuner &) = delete;
+                PartitionTuner(PartitionTuner &&) = delete;
+                ~PartitionTuner();
+
+                PartitionTuner & operator = (const PartitionTuner &) = delete;
+                PartitionTuner & operator = (PartitionTuner &&) = delete;
+
+            public:
+                /**
+                 * Measure the costs of all candidate partitions, takes about a second
+                 * @return status of operation
+                 */
+                status_t        benchmark();
+
+                /**
+                 * Load the costs measured before
+                 * @param path path to the wisdom file
+                 * @return status of operation
+                 */
+                status_t        load(const char *path);
+
+                /**
+                 * Save the measured costs
+                 * @param path path to the wisdom file
+                 * @return status of operation
+                 */
+                status_t        save(const char *path) const;
+
+                inline bool     ready() const           { return bReady; }
+
+                /**
+                 * Choose the partition with the least estimated cost of the convolution
+                 * @param length length of the response
+                 * @param filter length of the inverse filter
+                 * @return partition size in samples, 0 if costs are not measured
+                 */
+                size_t          partition(size_t length, size_t filter) const;
+
+                void            dump(dspu::IStateDumper *v) const;
+        };
+
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_PROFILER_PARTITIONTUNER_H_ */
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_PROFILER_POLYPHASERESAMPLER_H_
+#define PRIVATE_PLUGINS_PROFILER_POLYPHASERESAMPLER_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Polyphase resampler with rational ratio L/M. The prototype low-pass filter
+         * is a Kaiser-windowed sinc, it is split into L phases of the same number of coefficients,
+         * so each output sample costs one dot product of the phase. The filter is TAPS input samples
+         * long for interpolation; for decimation the cutoff is lowered by L/M, so the filter is made
+         * ceil(M/L) times longer to keep the same transition width relative to the cutoff. Any range of
+         * output samples can be computed independently, so the signal can be
+         * resampled chunk by chunk.
+         */
+        class PolyphaseResampler
+        {
+            public:
+                static constexpr size_t TAPS        = 64;       // Number of filter taps per phase for interpolation
+                static constexpr size_t TAPS_MAX    = 1024;     // Maximum number of filter taps per phase
+                static constexpr size_t PHASES_MAX  = 1024;     // Maximum number of phases
+                static constexpr float  CUTOFF      = 0.95f;    // Cutoff frequency relative to the lower Nyquist frequency
+                static constexpr float  KAISER_BETA = 9.0f;     // Kaiser window parameter, defines the stopband attenuation
+
+            private:
+                size_t          nUp;            // Interpolation factor L
+                size_t          nDown;          // Decimation factor M
+                size_t          nTaps;          // Number of filter taps per phase
+                float          *vPhases;        // Filter coefficients, nTaps reversed coefficients per phase
+                uint8_t        *pData;
+
+            protected:
+                static double   bessel_i0(double x);
+
+            public:
+                explicit PolyphaseResampler();
+                PolyphaseResampler(const PolyphaseResampler &) = delete;
+                PolyphaseResampler(PolyphaseResampler &&) = delete;
+                ~PolyphaseResampler();
+
+                PolyphaseResampler & operator = (const PolyphaseResampler &) = delete;
+                PolyphaseResampler & operator = (PolyphaseResampler &&) = delete;
+
+                /**
+                 * Initialize resampler
+                 * @param src_rate source sample rate
+                 * @param dst_rate destination sample rate
+                 * @return status of operation, STATUS_UNSUPPORTED_FORMAT if the ratio
+                 *   can not be represented with PHASES_MAX phases of TAPS_MAX taps
+                 */
+                status_t        init(size_t src_rate, size_t dst_rate);
+
+                void            destroy();
+
+            public:
+                inline size_t   up() const              { return nUp; }
+                inline size_t   down() const            { return nDown; }
+                inline size_t   taps() const            { return nTaps; }
+
+                /**
+                 * Get number of output samples for the number of input samples
+                 * @param count number of input samples
+                 * @return number of output samples
+                 */
+                size_t          output_length(size_t count) const;
+
+                /**
+                 * Compute the range of output samples
+                 * @param dst destination buffer
+                 * @param stride distance between output samples in the destination buffer
+                 * @param src source signal, samples outside of [0, length) are treated as zeros
+                 * @param length length of the source signal
+                 * @param first the sample of the source signal that matches the first output sample
+                 * @param offset index of the first output sample to compute
+                 * @param count number of output samples to compute
+                 */
+                void            process(float *dst, size_t stride, const float *src, size_t length,
+                                    ssize_t first, wsize_t offset, size_t count) const;
+
+                void            dump(dspu::IStateDumper *v) const;
+        };
+
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_PROFILER_POLYPHASERESAMPLER_H_ */
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_PROFILER_RINGBUFFER_H_
+#define PRIVATE_PLUGINS_PROFILER_RINGBUFFER_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Lock-free ring buffer of multichannel frames for a single producer and a single consumer.
+         * The producer writes planar data, the consumer reads interleaved frames. Neither side
+         * ever waits or allocates memory: the producer drops the frames that do not fit into
+         * the buffer and counts them as overrun.
+         */
+        class RingBuffer
+        {
+            private:
+                size_t          nChannels;      // Number of channels
+                size_t          nCapacity;      // Capacity in frames, power of two
+                uatomic_t       nHead;          // Number of frames written by producer
+                uatomic_t       nTail;          // Number of frames read by consumer
+                uatomic_t       nOverrun;       // Number of frames dropped by producer
+                float          *vData;          // Interleaved frames
+                uint8_t        *pData;
+
+            public:
+                explicit RingBuffer();
+                RingBuffer(const RingBuffer &) = delete;
+                RingBuffer(RingBuffer &&) = delete;
+                ~RingBuffer();
+
+                RingBuffer & operator = (const RingBuffer &) = delete;
+                RingBuffer & operator = (RingBuffer &&) = delete;
+
+                /**
+                 * Initialize the buffer
+                 * @param channels number of channels
+                 * @param frames minimum capacity in frames, rounded up to the power of two
+                 * @return status of operation
+                 */
+                status_t        init(size_t channels, size_t frames);
+
+                void            destroy();
+
+            public:
+                /**
+                 * Drop all data, should not be called while producer or consumer are active
+                 */
+                void            clear();
+
+                inline size_t   channels() const        { return nChannels; }
+                inline size_t   capacity() const        { return nCapacity; }
+                inline bool     is_empty() const        { return vData == NULL; }
+
+                /**
+                 * Producer: append frames to the buffer
+                 * @param src array of pointers to the data of each channel
+                 * @param count number of frames to append
+                 * @return number of frames appended, other frames are dropped
+                 */
+                size_t          write(const float * const *src, size_t count);
+
+                /**
+                 * Consumer: take interleaved frames from the buffer
+                 * @param dst destination buffer to store interleaved frames
+                 * @param count maximum number of frames to take
+                 * @return number of frames taken
+                 */
+                size_t          read(float *dst, size_t count);
+
+                /**
+                 * Get number of frames available for reading
+                 * @return number of frames
+                 */
+                size_t          available();
+
+                /**
+                 * Get and reset the number of frames dropped by producer
+                 * @return number of dropped frames
+                 */
+                size_t          take_overrun();
+
+                void            dump(dspu::IStateDumper *v) const;
+        };
+
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_PROFILER_RINGBUFFER_H_ */
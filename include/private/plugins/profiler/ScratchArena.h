@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_PLUGINS_PROFILER_SCRATCHARENA_H_
+#define PRIVATE_PLUGINS_PROFILER_SCRATCHARENA_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Grow-only scratch memory for the offline tasks. The memory is re-allocated only
+         * when the request exceeds the current capacity and is never shrunk, so repeated
+         * runs of the same task do not touch the heap after the first one and the footprint
+         * is bounded by the largest request.
+         */
+        class ScratchArena
+        {
+            private:
+                size_t          nCapacity;      // Capacity in floats
+                size_t          nGrowths;       // Number of re-allocations
+                float          *vData;
+                uint8_t        *pData;
+
+            public:
+                explicit ScratchArena();
+                ScratchArena(const ScratchArena &) = delete;
+                ScratchArena(ScratchArena &&) = delete;
+                ~ScratchArena();
+
+                ScratchArena & operator = (const ScratchArena &) = delete;
+                ScratchArena & operator = (ScratchArena &&) = delete;
+
+                void            destroy();
+
+            public:
+                /**
+                 * Get the buffer of at least the specified size, the contents of the buffer
+                 * are not preserved between calls
+                 * @param count number of floats
+                 * @return pointer to the buffer or NULL if there is no memory
+                 */
+                float          *reserve(size_t count);
+
+                inline size_t   capacity() const        { return nCapacity; }
+                inline size_t   growths() const         { return nGrowths; }
+
+                void            dump(dspu::IStateDumper *v) const;
+        };
+
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_PROFILER_SCRATCHARENA_H_ */
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_PLUGINS_PROFILER_TRIPLEBUFFER_H_
+#define PRIVATE_PLUGINS_PROFILER_TRIPLEBUFFER_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/atomic.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Lock-free triple buffer index manager for a single producer and a single consumer.
+         * The producer always has a slot to write to, the consumer always has a slot to read
+         * from, and the third slot holds the latest published data. Neither side ever waits
+         * for the other one. The data slots are managed by the owner, this class only tells
+         * which slot belongs to whom.
+         */
+        class TripleBuffer
+        {
+            public:
+                static constexpr size_t SLOTS       = 3;
+
+            private:
+                enum flags_t
+                {
+                    F_INDEX     = 0x03,         // Mask for the slot index
+                    F_DIRTY     = 0x04          // The middle slot holds the data not seen by consumer
+                };
+
+            private:
+                uatomic_t       nBack;          // Slot owned by the producer
+                uatomic_t       nMiddle;        // Shared slot with flags
+                uatomic_t       nFront;         // Slot owned by the consumer
+
+            public:
+                explicit TripleBuffer();
+                TripleBuffer(const TripleBuffer &) = delete;
+                TripleBuffer(TripleBuffer &&) = delete;
+                ~TripleBuffer();
+
+                TripleBuffer & operator = (const TripleBuffer &) = delete;
+                TripleBuffer & operator = (TripleBuffer &&) = delete;
+
+            public:
+                /**
+                 * Reset the state, should not be called while producer or consumer are active
+                 */
+                void            reset();
+
+                /**
+                 * Get the slot the producer should write to
+                 * @return index of the slot
+                 */
+                inline size_t   back() const        { return nBack; }
+
+                /**
+                 * Get the slot the consumer should read from
+                 * @return index of the slot
+                 */
+                inline size_t   front() const       { return nFront; }
+
+                /**
+                 * Producer: publish the back slot and take a new one for writing
+                 */
+                void            publish();
+
+                /**
+                 * Consumer: take the latest published slot if there is any
+                 * @return true if the front slot has been replaced with the new data
+                 */
+                bool            fetch();
+
+                /**
+                 * Check that there is published data not fetched by the consumer yet
+                 * @return true if there is published data
+                 */
+                bool            pending();
+        };
+
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_PROFILER_TRIPLEBUFFER_H_ */
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PRIVATE_PLUGINS_PROFILER_WORKERPOOL_H_
+#define PRIVATE_PLUGINS_PROFILER_WORKERPOOL_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+#include <lsp-plug.in/ipc/IExecutor.h>
+#include <lsp-plug.in/ipc/Mutex.h>
+#include <lsp-plug.in/ipc/Semaphore.h>
+#include <lsp-plug.in/ipc/Thread.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Executor with its own threads and work stealing. Each thread has its own deque of
+         * tasks: submitted tasks are distributed between deques, the thread takes the newest
+         * task from its own deque and steals the oldest tasks from other deques when its own
+         * deque is empty. The submission never waits for the lock and never wakes up threads
+         * with a system call, so it may be called from the audio thread: it fails if the task
+         * can not be queued immediately, and idle threads poll the counter of submitted tasks.
+         * The locks of deques are only tried, so no thread ever sleeps on them.
+         */
+        class WorkerPool: public ipc::IExecutor
+        {
+            public:
+                static constexpr size_t DEQUE_SIZE      = 32;       // Capacity of the deque of each thread
+                static constexpr size_t POLL_TIME       = 5;        // Period of polling for submitted tasks by idle threads [ms]
+
+            private:
+                typedef struct deque_t
+                {
+                    ipc::Mutex          sLock;                      // Lock of the deque
+                    size_t              nHead;                      // Index of the oldest task
+                    size_t              nCount;                     // Number of tasks
+                    ipc::ITask         *vTasks[DEQUE_SIZE];         // Ring of tasks
+                } deque_t;
+
+                class Worker: public ipc::Thread
+                {
+                    private:
+                        WorkerPool     *pPool;
+                        size_t          nIndex;
+
+                    public:
+                        explicit Worker(WorkerPool *pool, size_t index);
+                        virtual ~Worker();
+
+                    public:
+                        virtual status_t run();
+                };
+
+            private:
+                size_t          nThreads;                           // Number of started threads
+                uatomic_t       nNext;                              // Deque for the next submitted task
+                uatomic_t       nPending;                           // Number of queued tasks
+                uatomic_t       nShutdown;                          // Threads should stop
+                ipc::Semaphore  sShutdown;                          // Posted on shutdown to wake up idle threads
+                Worker        **vWorkers;                           // Threads, one per processor core
+                deque_t        *vDeques;                            // Deques of threads
+
+            protected:
+                ipc::ITask     *take(size_t index);
+                bool            process(size_t index);
+                void            cancel(deque_t *d);
+
+            public:
+                explicit WorkerPool();
+                WorkerPool(const WorkerPool &) = delete;
+                WorkerPool(WorkerPool &&) = delete;
+                virtual ~WorkerPool();
+
+                WorkerPool & operator = (const WorkerPool &) = delete;
+                WorkerPool & operator = (WorkerPool &&) = delete;
+
+                /**
+                 * Start threads, should not be called from the audio thread
+                 * @param threads number of threads, 0 for the number of processor cores
+                 * @return status of operation
+                 */
+                status_t        start(size_t threads);
+
+            public:
+                virtual bool    submit(ipc::ITask *task);
+                virtual void    shutdown();
+
+                inline size_t   threads() const             { return nThreads; }
+                inline bool     running() const             { return nThreads > 0; }
+
+                void            dump(dspu::IStateDumper *v) const;
+        };
+
+    } /* namespace plugins */
+} /* namespace lsp */
+
+#endif /* PRIVATE_PLUGINS_PROFILER_WORKERPOOL_H_ */
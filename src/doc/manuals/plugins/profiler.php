@@ -96,12 +96,29 @@
     Longer test duration increases the signal to noise ratio. If a reverberant system is being measured,
     the <b>Coarse Duration</b> should be longer than the expected reverberation time.
 </p>
+<p>
+	The <b>Quality</b> selector sets how the chirp is synthesized during the pre-processing phase. The time spent by the last
+	pre-processing is shown by the <b>Prep</b> indicator, so the cost of each quality can be checked on the actual machine:
+</p>
+<ul>
+	<li><b>Draft</b> - The chirp is computed directly at the sample rate without oversampling. Pre-processing is the fastest and takes
+	the least memory, but the aliasing of the highest octave of the sweep reduces the dynamic range of the impulse response at high
+	frequencies. Suitable for quick latency and polarity checks.</li>
+	<li><b>Standard</b> - The band-limited chirp is synthesized with 2x oversampling. Pre-processing takes about twice the work of
+	<b>Draft</b> for the synthesis, the aliasing is suppressed for most of the audio range.</li>
+	<li><b>Reference</b> - The band-limited chirp is synthesized with 8x oversampling. Pre-processing takes about eight times the work
+	of <b>Draft</b> for the synthesis and the most memory, the impulse response has the highest dynamic range. Recommended for archival
+	measurements.</li>
+</ul>
 <p><b>5: Perform the profiling</b></p>
 <p>
 	Pressing <b>Profile</b> in the <b>'Test Signal'</b> section triggers a single profiling sequence.
     This will make the plugin to transition through the following states automatically:
 </p>
 <ul>
+    <li><b>PREPARING</b> - The plugin does not allocate the memory for the test signal and the detectors until it is first used.
+    In this state the memory is allocated in background. The state takes place only once, on the first calibration, measurement
+    or file loading.</li>
     <li><b>DETECTING LATENCY</b> - In this state the latency of the audio system measurement chain is assessed. This step can be omitted by
     disabling the <b>Enable</b> toggle in the <b>'Latency Detector'</b> section. If latency was never measured, the plugin will force
     latency detection.</li>
@@ -138,6 +155,10 @@
     To change this, operate the <b>Offset</b> control in the <b>'Results'</b> section, which allows to introduce a time offset.
     For numerical reasons, few details of the measured Linear Impulse Response are mapped into negative time samples to the left of the origin of time.
     In case the spread of the Linear Impulse Response to the left of the origin of time is important, introducing a negative offset will increase accuracy of the calculations listed above, as well as providing a more accurate measurement.
+    When the <b>Auto</b> button below the <b>Offset</b> knob is enabled, the offset is detected automatically: the plugin finds the onset
+    of the direct sound, where the Linear Impulse Response first rises above both the noise floor and a threshold relative to its peak, and
+    places the origin slightly before it. The detected offset is used both for post processing and saving, and is shown instead of the knob value.
+    If the onset can not be detected, the value of the <b>Offset</b> knob is used.
     The Reverberation Time can be calculated with any of the algorithms in the <b>RT Algorithm</b> selector in the <b>'Results'</b> section. All the algorithms are based in calculating,
     from the Linear Impulse Response, the Energy Decay curve through backward integration, fitting a straight line in the Energy Decay curve in a
     specified interval and solving for the point at which the straight line intercepts -60 dB from the peak energy.
@@ -164,6 +185,16 @@
 	The <b>Coarse IR Duration</b> is instead the Linear Impulse Response duration based on the envelope of the Energy Decay curve.
     The value of the <b>Coarse IR Duration</b> is the time at which the envelope dives into the noise floor.
 </p>
+<p>
+    After the post-processing, the plugin additionally analyses the same part of the Linear Impulse Response that is shown on the result graph.
+    The analysis is performed in background in small portions and the graphs are updated progressively as soon as each portion is computed:
+</p>
+<ul>
+    <li><b>Energy Time Curve</b> - the envelope of the Linear Impulse Response in decibels, computed with the Hilbert transform.</li>
+    <li><b>Cumulative Spectral Decay</b> - the waterfall of spectra computed for the Linear Impulse Response starting at
+    successive points in time. Frequency goes from left to right, time goes from top to bottom, the brightness shows
+    the level relative to the spectrum of the first slice.</li>
+</ul>
 <p><b>7: Saving the results</b></p>
 <p>
     The profile can be saved by using the Save button in the <b>'Results'</b> section.
@@ -171,8 +202,93 @@
     Auto should be able to save all the meaningful parts of the Linear Impulse Response.
 </p>
 <p>
-	Whenever the plugin is saving to file, its state will be SAVING and the corresponding LED in the <b>'Results'</b>
-	section will shine.
+    Additional files can be produced at the same time by enabling the buttons in the <b>Also save</b> row. The file name chosen in the
+    save dialog is used for the mode selected by <b>Save Mode</b>, the names of other files are made of the same name with the
+    suffix of the mode: <code>-auto.wav</code>, <code>-rt.wav</code>, <code>-coarse.wav</code>, <code>-all.wav</code> or <code>.lspc</code>.
+    All WAV files are written in a single pass over the measured data, the LSPC file is written in parallel.
+</p>
+<p>
+    The file name may contain fields which are replaced with actual values at the moment of saving:
+</p>
+<ul>
+    <li><code>{index}</code> - the number of the saving, starts with 1 each time the new file name is chosen.</li>
+    <li><code>{date}</code> - the date of saving in the YYYYMMDD format.</li>
+    <li><code>{time}</code> - the time of saving in the HHMMSS format.</li>
+    <li><code>{channel}</code> - the name of the channel. If this field is present, each channel is saved to the separate WAV file.</li>
+</ul>
+<p>
+    When the <b>Auto save</b> button is enabled, the result of each measurement is saved automatically as soon as it is post-processed,
+    so a series of measurements can be performed without saving each result manually. Using the <code>{index}</code> or <code>{time}</code>
+    field in the file name prevents overwriting of previous results.
+</p>
+<p>
+    The WAV files can also be exported at other sample rates by enabling the buttons in the <b>Export at</b> row. Each enabled
+    sample rate is rendered with the high-quality polyphase resampler by a separate background task, all tasks run in parallel
+    during the same saving. The sample rate is added to the name of the file before the extension, for example <code>ir-48k.wav</code>
+    or <code>ir-auto-44.1k.wav</code>. The sample rate that matches the sample rate of the host is not exported twice.
+</p>
+<p>
+	Saving is performed in background and does not block the next measurement: the last post-processed result is
+	kept aside while the file is being written, and the new result replaces it only when the new measurement is post-processed.
+	Whenever the plugin is saving to file and is not busy with anything else, its state will be SAVING and the corresponding LED in the <b>'Results'</b>
+	section will shine. Since the LSPC file contains the state of the test signal generator, a new measurement waits
+	for the LSPC file to be written before generating the new test signal.
+</p>
+
+<p>
+	When the All Info (LSPC) file is saved, the indexed archive of the measurement can be written next to it by selecting the
+	<b>Archive</b> mode. The archive has the same name with the <code>.lspx</code> extension. It holds the metadata of the
+	measurement, the captured response of each channel and the segments of the convolution result for the linear response and
+	each harmonic of each channel. The index at the end of the file holds the position of each part, so a single channel or
+	harmonic can be read without reading the whole file. In the <b>Compressed</b> mode each part is packed with a lossless codec.
+</p>
+<p>
+	A measurement previously saved to the LSPC file can be loaded back with the <b>Load</b> button. The convolution result stored
+	in the file passes the same way as the result of a new measurement: it is post-processed, plotted and analysed, and can be saved
+	again to any format. Loading is possible only when the plugin is idle. The stored convolution result is used as is and is treated
+	as measured at the current sample rate. The test signal settings are restored automatically before the next measurement.
+</p>
+<p>
+	With the <b>Raw capture</b> button enabled, the signal at the input of the plugin is archived during the whole recording to the
+	WAV file next to the saved result, the name of the file has the <code>-capture</code> suffix. The audio thread only copies the
+	input to the ring buffer of 2 seconds, the file is written by a dedicated thread of the plugin which drains the buffer every 20 ms,
+	so the archiving does not wait for other background tasks. If the disk stalls for longer than the buffer can hold, the part of
+	the capture that did not fit into the ring buffer is dropped and the status of the archiving reports overflow.
+</p>
+<p>
+	Background tasks of the plugin are executed by the host. Some hosts run the background tasks of all plugins on a single thread,
+	so the saving, the analysis and the deconvolution wait for each other and for other plugins. With the <b>Worker pool</b> button
+	enabled, the plugin starts its own threads, one per processor core, and the tasks run on them in parallel, idle threads
+	take over the tasks queued for busy ones. Tasks which can not be queued to the pool are still passed to the host.
+</p>
+
+<p>
+	Devices which can not be put into the real-time loop with the plugin can be measured offline. The <b>Test chirp</b> button of the
+	<b>'Offline Measurement'</b> section exports the test chirp generated for the current settings to the WAV file. The chirp should be
+	played through the device and the response of the device recorded to the WAV file at the same sample rate. Loading the recorded response
+	with the <b>Recorded response</b> button deconvolves it with the test chirp and post-processes the result as if it was measured by the
+	plugin. The recording should start not later than the playback of the chirp, the delay of the recording can be compensated with
+	the <b>Offset</b> control or automatic offset. The recording is read in chunks and only the part that can hold the response is read:
+	the maximum detectable latency, the chirp and the tail of the same duration as the chirp. This part is kept in memory for each channel
+	while it is deconvolved, since the chirp processor deconvolves responses held in memory; longer recordings should be measured with the
+	<b>'Long Sweep'</b> which streams the response from the file. Both operations are possible only when the plugin is idle.
+</p>
+<p>
+	Very quiet measurements with high dynamic range may require the sweep longer than the <b>Coarse Duration</b> allows. The <b>'Long Sweep'</b>
+	section exports the exponential sweep of the selected <b>Duration</b> up to 20 minutes, and deconvolves the response recorded with it.
+	Neither the sweep nor the response are kept in memory: the sweep is computed chunk by chunk while it is written, and the response is
+	read block by block by the partitioned convolution. Only the first 10 seconds of the linear impulse response are computed, they are saved
+	to the WAV file next to the recorded response with the <code>-ir</code> suffix. The long sweep does not interrupt measurements of the plugin.
+</p>
+<p>
+	The long sweep can also be measured in realtime with the <b>Measure</b> button of the <b>Realtime</b> column. The plugin plays the sweep
+	computed block by block to all outputs, and the input is passed through the ring buffer of the raw capture to the dedicated thread
+	which writes it to the WAV file next to the saved result, the name of the file has the <code>-long</code> suffix. The recording lasts for the sweep
+	and 10 seconds of the tail, then the recorded file is deconvolved the same way as the recorded response and the impulse response is
+	saved next to it with the <code>-long-ir</code> suffix. Pressing the button again cancels the measurement. The deconvolution needs
+	every recorded frame, so if the disk could not keep up and the ring buffer overflowed, the measurement reports the overflow instead.
+	The realtime long sweep is started only when the plugin is idle and the raw capture is not archived, the state indicator shows
+	recording while the sweep is played.
 </p>
 
 <p><b>Controls:</b></p>
@@ -207,8 +323,16 @@
 	    <li><b>All Info (*.lspc)</b> - Save, as an LSPC file, all the measured information.</li>
     </ul>
 	<li><b>Offset</b> - Introduce an offset from the origin of time of the Linear Impulse Response, for post processing purposes, milliseconds.</li>
+	<li><b>Auto</b> - Detect the offset automatically from the onset of the direct sound.</li>
 	<li><b>Post-process</b> - Button that forces the plugin to post-process the measurement result.</li>
 	<li><b>Save</b> - Save button.</li>
+	<li><b>Also save</b> - Additional saving modes to produce files for at the same time.</li>
+	<li><b>Auto save</b> - Save the result automatically after each measurement.</li>
+	<li><b>Export at</b> - Additional sample rates to export WAV files at.</li>
+	<li><b>Load</b> - Load the measurement previously saved to the LSPC file.</li>
+	<li><b>Archive</b> - Mode of the indexed archive written together with the LSPC file.</li>
+	<li><b>Raw capture</b> - Archive the raw input signal to WAV file while recording.</li>
+	<li><b>Worker pool</b> - Run background tasks on the own threads of the plugin instead of the host.</li>
     <li><b>Noise Floor</b> - If shining, the background noise and/or Offset value are optimal for the selected RT algorithm accuracy.</li>
 </ul>
 <p><b>'Calibrator' section:</b></p>
@@ -233,5 +357,19 @@
 <ul>
     <li><b>Coarse Duration</b> - Sets the coarse duration of the profiling Test Signal.</li>
     <li><b>Actual Duration</b> - Actual duration of the profiling Test Signal, after optimisation performed in pre-processing.</li>
+    <li><b>Quality</b> - Quality of the chirp synthesis: Draft, Standard or Reference.</li>
+    <li><b>Prep</b> - Time spent by the last pre-processing, in milliseconds.</li>
     <li><b>Profile</b> - Button that forces the plugin to perform a single profiling measurement.</li>
 </ul>
+<p><b>'Offline Measurement' section:</b></p>
+<ul>
+	<li><b>Test chirp</b> - Export the test chirp for the current settings to the WAV file.</li>
+	<li><b>Recorded response</b> - Load the response recorded with the exported test chirp and deconvolve it.</li>
+</ul>
+<p><b>'Long Sweep' section:</b></p>
+<ul>
+	<li><b>Duration</b> - Duration of the long sweep.</li>
+	<li><b>Test chirp</b> - Export the long sweep to the WAV file.</li>
+	<li><b>Recorded response</b> - Deconvolve the response recorded with the long sweep and save the impulse response to the WAV file.</li>
+	<li><b>Measure</b> - Play the long sweep in realtime, record the response to the WAV file next to the saved result and deconvolve it; the second press cancels the measurement.</li>
+</ul>
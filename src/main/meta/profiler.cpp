@@ -55,6 +55,7 @@ namespace lsp
             { "Convolving",             "profiler.st.conv" },
             { "Postprocessing",         "profiler.st.post" },
             { "Saving",                 "profiler.st.save" },
+            { "Preparing",              "profiler.st.prep" },
             { NULL,                     NULL }
         };
 
@@ -78,6 +79,22 @@ namespace lsp
             { NULL,                     NULL }
         };
 
+        static const port_item_t sc_quality[] =
+        {
+            { "Draft",                  "profiler.quality.draft" },
+            { "Standard",               "profiler.quality.standard" },
+            { "Reference",              "profiler.quality.reference" },
+            { NULL,                     NULL }
+        };
+
+        static const port_item_t sc_archive[] =
+        {
+            { "Off",                    "profiler.archive.off" },
+            { "Indexed (*.lspx)",       "profiler.archive.indexed" },
+            { "Compressed (*.lspx)",    "profiler.archive.compressed" },
+            { NULL,                     NULL }
+        };
+
         #define CALIBRATOR \
             LOG_CONTROL("calf", "Frequency", "Cal freq", U_HZ, profiler_metadata::FREQUENCY), \
             AMP_GAIN10("cala", "Amplitude", "Amplitude", profiler_metadata::AMPLITUDE_DFL), \
@@ -94,28 +111,65 @@ namespace lsp
         #define TEST_SIGNAL \
             CONTROL("tsgl", "Duration", "Duration", U_SEC, profiler_metadata::DURATION), \
             METER("tind", "Actual Signal Duration", U_SEC, profiler_metadata::MTR_T), \
+            COMBO("tsgq", "Chirp quality", "Quality", profiler_metadata::SC_QUALITY_DFL, sc_quality), \
+            METER("tppt", "Preprocessing time", U_MSEC, profiler_metadata::MTR_PREP), \
             TRIGGER("lint", "Trig a Linear measurement", "Measure start")
 
         #define POSTPROCESSOR \
             CONTROL("offc", "IR Time Offset", "IR offset", U_MSEC, profiler_metadata::IR_OFFSET), \
+            SWITCH("offa", "Automatic IR Time Offset", "Auto offset", 0.0f), \
+            METER("offm", "Applied IR Time Offset", U_MSEC, profiler_metadata::IR_OFFSET), \
             COMBO("scra", "RT Algorithm", "RT algorithm", profiler_metadata::SC_RTALGO_DFL, sc_rtalgo), \
             TRIGGER("post", "Trig Post Processing", "Postproc start")
 
         #define SAVER \
             COMBO("scsv", "Save Mode", "Save mode", profiler_metadata::SC_SVMODE_DFL, sc_savemode), \
+            SWITCH("svx0", "Also save LTI Auto", "Save LTI Auto", 0.0f), \
+            SWITCH("svx1", "Also save LTI RT", "Save LTI RT", 0.0f), \
+            SWITCH("svx2", "Also save LTI Coarse", "Save LTI Coarse", 0.0f), \
+            SWITCH("svx3", "Also save LTI All", "Save LTI All", 0.0f), \
+            SWITCH("svx4", "Also save All Info", "Save All Info", 0.0f), \
             PATH("irfn", "Save file name"), \
             TRIGGER("irfc", "Save file command", "Save file"), \
             STATUS("irfs", "File saving status"), \
-            METER_PERCENT("irfp", "File saving progress")
+            METER_PERCENT("irfp", "File saving progress"), \
+            SWITCH("irfa", "Save file after each measurement", "Auto save", 0.0f), \
+            SWITCH("xsr0", "Also export at 44.1 kHz", "Export 44.1k", 0.0f), \
+            SWITCH("xsr1", "Also export at 48 kHz", "Export 48k", 0.0f), \
+            SWITCH("xsr2", "Also export at 88.2 kHz", "Export 88.2k", 0.0f), \
+            SWITCH("xsr3", "Also export at 96 kHz", "Export 96k", 0.0f), \
+            SWITCH("xsr4", "Also export at 192 kHz", "Export 192k", 0.0f), \
+            PATH("irld", "Load file name"), \
+            STATUS("irls", "File loading status"), \
+            COMBO("lspx", "Indexed measurement archive", "Archive", profiler_metadata::SC_ARCHIVE_DFL, sc_archive), \
+            SWITCH("rcar", "Archive raw capture", "Raw capture", 0.0f), \
+            STATUS("rcas", "Raw capture archiving status")
+
+        #define OFFLINE \
+            PATH("chfn", "Chirp file name"), \
+            TRIGGER("chfc", "Chirp file command", "Export chirp"), \
+            STATUS("chfs", "Chirp file saving status"), \
+            PATH("rsfn", "Response file name"), \
+            STATUS("rsfs", "Response file loading status"), \
+            CONTROL("lsdr", "Long sweep duration", "Long sweep", U_SEC, profiler_metadata::LONG_DURATION), \
+            PATH("lscf", "Long sweep chirp file name"), \
+            TRIGGER("lscc", "Long sweep chirp file command", "Export long sweep"), \
+            STATUS("lscs", "Long sweep chirp file saving status"), \
+            PATH("lsrf", "Long sweep response file name"), \
+            STATUS("lsrs", "Long sweep deconvolution status"), \
+            TRIGGER("lsmt", "Long sweep realtime measurement", "Measure long"), \
+            STATUS("lsms", "Long sweep realtime measurement status")
 
         #define PROFILER_COMMON \
             BYPASS, \
             ENUM_METER("stld", "State LED", 0, profiler_states), \
+            SWITCH("wpol", "Run tasks on the plugin worker pool", "Worker pool", 0.0f), \
             CALIBRATOR, \
             LATENCY_DETECTOR, \
             TEST_SIGNAL, \
             POSTPROCESSOR, \
-            SAVER
+            SAVER, \
+            OFFLINE
 
         #define PROFILER_VISUALOUTS(id, label) \
             METER_GAIN20("ilv" id, "Input Level" label), \
@@ -124,7 +178,9 @@ namespace lsp
             BLINK("rta" id, "Reverberation Time Accuracy" label), \
             METER("ili" id, "Integration Time" label, U_SEC, profiler_metadata::MTR_IL), \
             METER("rci" id, "Regression Line Correlation" label, U_NONE, profiler_metadata::MTR_R), \
-            MESH("rme" id, "Result" label, 2, profiler_metadata::RESULT_MESH_SIZE)
+            MESH("rme" id, "Result" label, 2, profiler_metadata::RESULT_MESH_SIZE), \
+            MESH("etc" id, "Energy Time Curve" label, 2, profiler_metadata::ETC_MESH_SIZE), \
+            FBUFFER("csd" id, "Cumulative Spectral Decay" label, profiler_metadata::CSD_SLICES, profiler_metadata::CSD_MESH_SIZE)
 
         #define PROFILER_VISUALOUTS_MONO    PROFILER_VISUALOUTS("", "")
         #define PROFILER_VISUALOUTS_STEREO  PROFILER_VISUALOUTS("_l", " Left"), PROFILER_VISUALOUTS("_r", " Right")
@@ -176,7 +232,7 @@ namespace lsp
             LSP_PLUGINS_PROFILER_VERSION,
             plugin_classes,
             clap_features_mono,
-            E_DUMP_STATE,
+            E_INLINE_DISPLAY | E_DUMP_STATE,
             profiler_mono_ports,
             "plugins/util/profiler/mono.xml",
             NULL,
@@ -208,7 +264,7 @@ namespace lsp
             LSP_PLUGINS_PROFILER_VERSION,
             plugin_classes,
             clap_features_stereo,
-            E_DUMP_STATE,
+            E_INLINE_DISPLAY | E_DUMP_STATE,
             profiler_stereo_ports,
             "plugins/util/profiler/stereo.xml",
             NULL,
@@ -23,7 +23,11 @@
 #include <lsp-plug.in/common/debug.h>
 #include <lsp-plug.in/dsp/dsp.h>
 #include <lsp-plug.in/dsp-units/units.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/mm/InAudioFileStream.h>
+#include <lsp-plug.in/shared/id_colors.h>
 #include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/string.h>
 
 #include <private/plugins/profiler.h>
 
@@ -31,8 +35,19 @@
 #define BGNOISE_INTERVAL_FACTOR     2.0f    /* Multiply reactivity by this to calculate the time to spend in BGNOISEPROFILING state */
 #define POSTPROCESSOR_REACTIVITY    0.085f  /* Window Size for the Post Processor IR envelope follower [s] */
 #define POSTPROCESSOR_TOLERANCE     3.0     /* Maximum level above the noise floor below which, if IR peaks are not found, the IR is considered concluded [dB] */
+#define ONSET_BLOCK_SIZE            64      /* Size of block for the IR onset scan [samples] */
+#define ONSET_NOISE_TAIL            16      /* The noise floor is estimated from the last 1/N part of the convolution result */
+#define ONSET_NOISE_MARGIN          12.0f   /* Minimum level of the direct sound onset above the noise floor [dB] */
+#define ONSET_PEAK_RANGE            40.0f   /* Maximum level of the direct sound onset below the peak [dB] */
+#define ONSET_PREROLL               1.0f    /* Time to keep before the direct sound onset [ms] */
 #define SYNC_CHIRP_START_FREQ       1.0     /* Synchronized Chirp Starting frequency [Hz] */
 #define SYNC_CHIRP_MAX_FREQ         23000.0 /* Synchronized Chirp Final frequency [Hz] */
+#define CAPTURE_RING_TIME           2.0f    /* Capacity of the raw capture ring buffer [s] */
+#define ARCHIVE_HARMONICS           8       /* Maximum number of harmonic IR segments stored in the indexed archive */
+#define WISDOM_FILE                 "lsp-plugins/profiler-wisdom.bin" /* Partition costs measured on this machine, relative to the user config path */
+#define ANALYSIS_FFT_RANK           13      /* FFT rank for the decay analysis */
+#define CSD_TILE_SLICES             8       /* Number of Cumulative Spectral Decay slices computed by one analysis tile */
+#define ANALYSIS_TILES              (1 + meta::profiler_metadata::CSD_SLICES / CSD_TILE_SLICES) /* Number of analysis tiles per channel */
 #define TRACE_PORT(p)               lsp_trace("  port id=%s", (p)->metadata()->id);
 
 namespace lsp
@@ -54,10 +69,127 @@ namespace lsp
 
         static plug::Factory factory(plugin_factory, plugins, 2);
 
+        // Extra sample rates for exporting the IR, match the xsr* switches
+        static const size_t export_rates[] =
+        {
+            44100,
+            48000,
+            88200,
+            96000,
+            192000
+        };
+
+        //---------------------------------------------------------------------
+        profiler::PoolStarter::PoolStarter(profiler *base)
+        {
+            pCore       = base;
+        }
+
+        profiler::PoolStarter::~PoolStarter()
+        {
+            pCore       = NULL;
+        }
+
+        status_t profiler::PoolStarter::run()
+        {
+            return pCore->sWorkerPool.start(0);
+        }
+
+        //---------------------------------------------------------------------
+        profiler::Tuner::Tuner()
+        {
+        }
+
+        profiler::Tuner::~Tuner()
+        {
+        }
+
+        status_t profiler::Tuner::run()
+        {
+            // The costs of partitions are measured once and kept in the wisdom file,
+            // if the file can not be stored the measurement is repeated by the next instance
+            io::Path path;
+            bool persist    =
+                (system::get_user_config_path(&path) == STATUS_OK) &&
+                (path.append_child(WISDOM_FILE) == STATUS_OK);
+
+            if ((persist) && (sTuner.load(path.as_utf8()) == STATUS_OK))
+                return STATUS_OK;
+
+            lsp_trace("Measuring the cost of convolution partitions");
+            status_t res    = sTuner.benchmark();
+            if (res != STATUS_OK)
+                return res;
+            if ((persist) && (path.mkparent(true) == STATUS_OK))
+                sTuner.save(path.as_utf8());
+
+            return STATUS_OK;
+        }
+
+        //---------------------------------------------------------------------
+        profiler::Preparer::Preparer(profiler *base)
+        {
+            pCore       = base;
+            nSampleRate = 0;
+        }
+
+        profiler::Preparer::~Preparer()
+        {
+            pCore = NULL;
+        }
+
+        status_t profiler::Preparer::run()
+        {
+            // The objects are not used by the audio thread until the task completes
+            size_t sr   = pCore->nSampleRate;
+            nSampleRate = sr;
+
+            if (!pCore->sCalOscillator.init())
+                return STATUS_NO_MEM;
+            pCore->sCalOscillator.set_function(dspu::FG_SINE);
+            pCore->sCalOscillator.set_dc_offset(0.0f);
+            pCore->sCalOscillator.set_dc_reference(dspu::DC_ZERO);
+            pCore->sCalOscillator.set_phase(0.0f);
+            pCore->sCalOscillator.set_sample_rate(sr);
+
+            if (!pCore->sSyncChirpProcessor.init())
+                return STATUS_NO_MEM;
+            pCore->configure_chirp();
+            pCore->sSyncChirpProcessor.set_sample_rate(sr);
+
+            for (size_t ch = 0; ch < pCore->nChannels; ++ch)
+            {
+                channel_t *c = &pCore->vChannels[ch];
+
+                if (!c->sLatencyDetector.init())
+                    return STATUS_NO_MEM;
+                c->sLatencyDetector.set_delay_ratio(0.5f);
+                c->sLatencyDetector.set_duration(0.050f);
+                c->sLatencyDetector.set_op_fading(0.030f);
+                c->sLatencyDetector.set_op_pause(0.025f);
+                c->sLatencyDetector.set_sample_rate(sr);
+
+                c->sResponseTaker.init();
+                c->sResponseTaker.set_op_fading(0.030f);
+                c->sResponseTaker.set_op_pause(0.025f);
+                c->sResponseTaker.set_sample_rate(sr);
+            }
+            pCore->pPreProcessor->invalidate();
+
+            status_t res = pCore->sCaptureRing.init(pCore->nChannels, dspu::seconds_to_samples(sr, CAPTURE_RING_TIME));
+            if (res != STATUS_OK)
+                return res;
+
+            // The drain thread is started once, outside of the audio thread
+            return pCore->pCaptureArchiver->launch();
+        }
+
         //---------------------------------------------------------------------
         profiler::PreProcessor::PreProcessor(profiler *base)
         {
             pCore = base;
+            fTime = 0.0f;
+            invalidate();
         }
 
         profiler::PreProcessor::~PreProcessor()
@@ -65,49 +197,252 @@ namespace lsp
             pCore = NULL;
         }
 
+        void profiler::PreProcessor::invalidate()
+        {
+            for (size_t ch = 0; ch < CHANNELS_MAX; ++ch)
+            {
+                shape_t *s      = &vShapes[ch];
+                s->pChirp       = NULL;
+                s->nChirp       = 0;
+                s->nLatency     = 0;
+                s->nSampleRate  = 0;
+                s->bValid       = false;
+            }
+        }
+
         status_t profiler::PreProcessor::run()
         {
+            // The time is measured to show the cost of the selected chirp quality
+            system::time_t start, end;
+            system::get_time(&start);
+
             // reconfigure() will call update_settings() if needed.
             status_t  returnValue = pCore->sSyncChirpProcessor.reconfigure();
             if (returnValue != STATUS_OK)
                 return returnValue;
 
+            dspu::Sample *chirp = pCore->sSyncChirpProcessor.get_chirp();
+            const float *data   = (chirp != NULL) ? chirp->channel(0) : NULL;
+            size_t length       = (chirp != NULL) ? chirp->length() : 0;
+
             for (size_t ch = 0; ch < pCore->nChannels; ++ch)
             {
-                returnValue = pCore->vChannels[ch].sResponseTaker.reconfigure(pCore->sSyncChirpProcessor.get_chirp());
+                // Reconfiguration of the response taker re-allocates the capture. The capture
+                // is completely overwritten by each measurement, so keep it while the chirp
+                // data, the latency and the sample rate stay the same
+                channel_t *c    = &pCore->vChannels[ch];
+                shape_t *s      = &vShapes[ch];
+                if ((s->bValid) &&
+                    (s->pChirp == data) &&
+                    (s->nChirp == length) &&
+                    (s->nLatency == c->nTakerLatency) &&
+                    (s->nSampleRate == pCore->nSampleRate))
+                    continue;
+
+                s->bValid       = false;
+                returnValue = c->sResponseTaker.reconfigure(chirp);
                 if (returnValue != STATUS_OK)
                     return returnValue;
+
+                s->pChirp       = data;
+                s->nChirp       = length;
+                s->nLatency     = c->nTakerLatency;
+                s->nSampleRate  = pCore->nSampleRate;
+                s->bValid       = true;
             }
 
+            system::get_time(&end);
+            fTime       = (end.seconds - start.seconds) * 1000.0f + (float(end.nanos) - float(start.nanos)) * 1e-6f;
+
             return STATUS_OK;
         }
 
         //---------------------------------------------------------------------
         profiler::Convolver::Convolver(profiler *base)
         {
-            pCore = base;
+            pCore       = base;
+            enSource    = SRC_CAPTURE;
+            sFile[0]    = '\0';
         }
 
         profiler::Convolver::~Convolver()
         {
-            pCore = NULL;
+            pCore       = NULL;
         }
 
-        status_t profiler::Convolver::run()
+        void profiler::Convolver::set_source(source_t source, const char *fname)
+        {
+            enSource    = source;
+            if (fname != NULL)
+            {
+                strncpy(sFile, fname, PATH_MAX);
+                sFile[PATH_MAX - 1] = '\0';
+            }
+            else
+                sFile[0] = '\0';
+        }
+
+        status_t profiler::Convolver::load_lspc()
+        {
+            // The LSPC reader seeks directly to the chunks it needs, so the captured
+            // data is not read when only the convolution result is restored
+            lsp_trace("Loading measurement from path = %s", sFile);
+            status_t res = pCore->sSyncChirpProcessor.load_from_lspc(sFile);
+            if (res != STATUS_OK)
+                return res;
+
+            dspu::Sample *result = pCore->sSyncChirpProcessor.get_convolution_result();
+            if ((result == NULL) || (result->length() <= 0))
+                return STATUS_NO_DATA;
+            // The measurement is post-processed and saved per channel of the plugin
+            if (result->channels() != pCore->nChannels)
+                return STATUS_BAD_FORMAT;
+
+            return STATUS_OK;
+        }
+
+        status_t profiler::Convolver::load_response()
+        {
+            // The response should be recorded with the chirp generated for current settings
+            dspu::SyncChirpProcessor *scp = &pCore->sSyncChirpProcessor;
+            status_t res    = scp->reconfigure();
+            if (res != STATUS_OK)
+                return res;
+
+            lsp_trace("Loading response from path = %s", sFile);
+            mm::InAudioFileStream is;
+            if ((res = is.open(sFile)) != STATUS_OK)
+                return res;
+
+            const size_t srate      = pCore->nSampleRate;
+            const size_t channels   = is.channels();
+            if ((is.sample_rate() != srate) || (channels <= 0))
+            {
+                is.close();
+                return STATUS_BAD_FORMAT;
+            }
+
+            // Only the part of the recording that may hold the response is read:
+            // the latency of the device, the chirp and the tail of the same duration
+            size_t limit    = scp->get_chirp_duration_samples() * 2 +
+                              dspu::millis_to_samples(srate, meta::profiler_metadata::LATENCY_MAX);
+            wssize_t frames = is.length();
+            size_t length   = (frames >= 0) ? lsp_min(size_t(frames), limit) : limit;
+
+            // Re-use the memory of previous responses if possible
+            for (size_t ch = 0; (res == STATUS_OK) && (ch < pCore->nChannels); ++ch)
+            {
+                dspu::Sample *s = &pCore->vChannels[ch].sFileResponse;
+                if ((s->channels() == 1) && (s->max_length() >= length))
+                    s->set_length(length);
+                else if (!s->init(1, length, length))
+                    res             = STATUS_NO_MEM;
+            }
+
+            // Stream the file chunk by chunk, missing channels of the file are taken from the last one
+            float *buf      = (res == STATUS_OK) ? sArena.reserve(IRWriter::CHUNK_SIZE * channels) : NULL;
+            if ((res == STATUS_OK) && (buf == NULL))
+                res             = STATUS_NO_MEM;
+
+            size_t done     = 0;
+            while ((res == STATUS_OK) && (done < length))
+            {
+                ssize_t n       = is.read(buf, lsp_min(length - done, IRWriter::CHUNK_SIZE));
+                if (n <= 0)
+                {
+                    if ((n != -STATUS_EOF) && (n != 0))
+                        res             = status_t(-n);
+                    break;
+                }
+
+                for (size_t ch = 0; ch < pCore->nChannels; ++ch)
+                {
+                    const float *src    = &buf[lsp_min(ch, channels - 1)];
+                    float *dst          = &pCore->vChannels[ch].sFileResponse.channel(0)[done];
+                    for (ssize_t i=0; i<n; ++i, src += channels)
+                        dst[i]              = *src;
+                }
+                done           += n;
+            }
+
+            status_t xres   = is.close();
+            if (res != STATUS_OK)
+                return res;
+            if (xres != STATUS_OK)
+                return xres;
+            if (done <= 0)
+                return STATUS_NO_DATA;
+
+            // The response starts at the beginning of the file
+            for (size_t ch = 0; ch < pCore->nChannels; ++ch)
+            {
+                dspu::Sample *s = &pCore->vChannels[ch].sFileResponse;
+                s->set_length(done);
+                pCore->sResponseData.vResponses[ch] = s;
+                pCore->sResponseData.vOffsets[ch]   = 0;
+            }
+
+            return STATUS_OK;
+        }
+
+        size_t profiler::Convolver::partition_size()
         {
+            // The costs are measured by the Tuner task when the plugin is idle, the measurement
+            // is not waited for: the default partition is used until the costs are known
+            if ((!pCore->pTuner->completed()) || (!pCore->pTuner->successful()))
+                return 0;
+
+            size_t length   = 0;
             for (size_t ch = 0; ch < pCore->nChannels; ++ch)
             {
-                pCore->sResponseData.vResponses[ch] = pCore->vChannels[ch].sResponseTaker.get_capture();
-                pCore->sResponseData.vOffsets[ch]   = pCore->vChannels[ch].sResponseTaker.get_capture_start();
+                const dspu::Sample *s   = pCore->sResponseData.vResponses[ch];
+                size_t offset           = pCore->sResponseData.vOffsets[ch];
+                if ((s != NULL) && (s->length() > offset))
+                    length                  = lsp_max(length, s->length() - offset);
+            }
+
+            size_t partition = pCore->pTuner->tuner()->partition(length, pCore->sSyncChirpProcessor.get_chirp_duration_samples());
+            lsp_trace("Partition size for length=%d: %d", int(length), int(partition));
+            return partition;
+        }
+
+        status_t profiler::Convolver::run()
+        {
+            if (enSource == SRC_LSPC)
+                return load_lspc();
+
+            if (enSource == SRC_RESPONSE)
+            {
+                status_t res = load_response();
+                if (res != STATUS_OK)
+                    return res;
+            }
+            else
+            {
+                // The buffers the response takers have recorded to are deconvolved in place,
+                // starting from the capture offset, without copying
+                for (size_t ch = 0; ch < pCore->nChannels; ++ch)
+                {
+                    pCore->sResponseData.vResponses[ch] = pCore->vChannels[ch].sResponseTaker.get_capture();
+                    pCore->sResponseData.vOffsets[ch]   = pCore->vChannels[ch].sResponseTaker.get_capture_start();
+                }
             }
 
-            // Use 0 to force default partition size defined in SyncChirpProcessor
-            return pCore->sSyncChirpProcessor.do_linear_convolutions(
+            // The chirp processor keeps the result for post-processing, so it deconvolves the channels itself
+            // one by one on this thread. The partition size is chosen from the costs measured by the Tuner,
+            // 0 falls back to the default partition size of SyncChirpProcessor while the costs are not known
+            status_t res = pCore->sSyncChirpProcessor.do_linear_convolutions(
                     pCore->sResponseData.vResponses,
                     pCore->sResponseData.vOffsets,
                     pCore->nChannels,
-                    0
+                    partition_size()
                     );
+            if (res != STATUS_OK)
+                return res;
+
+            // The result is kept by the chirp processor, it is copied only when it is saved
+            dspu::Sample *result = pCore->sSyncChirpProcessor.get_convolution_result();
+            return (result != NULL) ? STATUS_OK : STATUS_NO_DATA;
         }
 
         //---------------------------------------------------------------------
@@ -116,6 +451,7 @@ namespace lsp
             pCore       = base;
             nIROffset   = 0;
             enAlgo      = dspu::SCP_RT_DEFAULT;
+            bAutoOffset = false;
         }
 
         profiler::PostProcessor::~PostProcessor()
@@ -135,14 +471,93 @@ namespace lsp
             enAlgo = algo;
         }
 
+        void profiler::PostProcessor::set_auto_offset(bool enable)
+        {
+            bAutoOffset = enable;
+        }
+
+        ssize_t profiler::PostProcessor::detect_ir_onset(const float *ir, size_t length) const
+        {
+            // Estimate the noise floor at the tail of the result where the IR has already decayed
+            size_t tail     = lsp_max(length / ONSET_NOISE_TAIL, size_t(1));
+            float noise     = sqrtf(dsp::h_sqr_sum(&ir[length - tail], tail) / tail);
+
+            // Find the peak of the direct sound within the range of the offset control
+            ssize_t origin  = pCore->nIROrigin;
+            ssize_t first   = lsp_max(origin + ssize_t(dspu::millis_to_samples(pCore->nSampleRate, meta::profiler_metadata::IR_OFFSET_MIN)), ssize_t(0));
+            ssize_t last    = lsp_min(origin + ssize_t(dspu::millis_to_samples(pCore->nSampleRate, meta::profiler_metadata::IR_OFFSET_MAX)), ssize_t(length));
+            if (first >= last)
+                return -1;
+
+            ssize_t peak    = first + dsp::abs_max_index(&ir[first], last - first);
+            float level     = fabsf(ir[peak]);
+            float thresh    = lsp_max(
+                noise * dspu::db_to_gain(ONSET_NOISE_MARGIN),
+                level * dspu::db_to_gain(-ONSET_PEAK_RANGE));
+            if (thresh >= level)
+                return -1; // The IR is buried in the noise
+
+            // Scan backwards from the peak until the whole block is below the threshold.
+            // This stops at the gap before the direct sound and does not reach the
+            // higher order harmonic responses located at negative time.
+            ssize_t head    = peak;
+            while (head > first)
+            {
+                size_t count    = lsp_min(size_t(head - first), size_t(ONSET_BLOCK_SIZE));
+                if (dsp::abs_max(&ir[head - count], count) < thresh)
+                    break;
+                head           -= count;
+            }
+
+            // Find the exact sample where the direct sound crosses the threshold
+            while ((head < peak) && (fabsf(ir[head]) < thresh))
+                ++head;
+
+            return head;
+        }
+
         status_t profiler::PostProcessor::run()
         {
+            dspu::Sample *result = pCore->sSyncChirpProcessor.get_convolution_result();
+            if (result == NULL)
+                return STATUS_NO_DATA;
+
+            // The time origin is in the middle of the convolution result
+            pCore->nIROrigin    = result->length() >> 1;
+
+            // Detect the onset of the direct sound, the earliest onset among channels
+            // is used to keep all channels aligned
+            if (bAutoOffset)
+            {
+                ssize_t onset   = -1;
+                for (size_t ch = 0; ch < pCore->nChannels; ++ch)
+                {
+                    ssize_t x       = detect_ir_onset(result->channel(ch), result->length());
+                    if ((x >= 0) && ((onset < 0) || (x < onset)))
+                        onset           = x;
+                }
+
+                // Keep the manual offset if the onset has not been found
+                if (onset >= 0)
+                {
+                    nIROffset       = onset - ssize_t(pCore->nIROrigin) - ssize_t(dspu::millis_to_samples(pCore->nSampleRate, ONSET_PREROLL));
+                    nIROffset       = lsp_limit(nIROffset,
+                        ssize_t(dspu::millis_to_samples(pCore->nSampleRate, meta::profiler_metadata::IR_OFFSET_MIN)),
+                        ssize_t(dspu::millis_to_samples(pCore->nSampleRate, meta::profiler_metadata::IR_OFFSET_MAX)));
+                }
+            }
+
             for (size_t ch = 0; ch < pCore->nChannels; ++ch)
             {
                 status_t returnValue = pCore->sSyncChirpProcessor.postprocess_linear_convolution(ch, nIROffset, enAlgo, POSTPROCESSOR_REACTIVITY, POSTPROCESSOR_TOLERANCE);
                 if (returnValue != STATUS_OK)
                     return returnValue;
 
+                // Build the pyramid once, so any time window of the plot can be extracted without recomputation
+                returnValue = pCore->vChannels[ch].sPyramid.build(result->channel(ch), result->length());
+                if (returnValue != STATUS_OK)
+                    return returnValue;
+
                 pCore->vChannels[ch].sPostProc.fReverbTime  = pCore->sSyncChirpProcessor.get_reverberation_time_seconds();
                 pCore->vChannels[ch].sPostProc.nReverbTime  = pCore->sSyncChirpProcessor.get_reverberation_time_samples();
                 pCore->vChannels[ch].sPostProc.fCorrCoeff   = pCore->sSyncChirpProcessor.get_reverberation_correlation();
@@ -150,6 +565,19 @@ namespace lsp
                 pCore->vChannels[ch].sPostProc.bRTAccuray   = pCore->sSyncChirpProcessor.get_background_noise_optimality();
             }
 
+            // Prepare the snapshot of results and pass it to the audio thread
+            size_t slot = pCore->sResults.back();
+            for (size_t ch = 0; ch < pCore->nChannels; ++ch)
+            {
+                channel_t *c    = &pCore->vChannels[ch];
+                snapshot_t *s   = &c->vSnapshots[slot];
+                size_t irQuery  = (nIROffset > 0) ? c->sPostProc.nReverbTime : c->sPostProc.nReverbTime + size_t(-nIROffset);
+
+                s->sPostProc    = c->sPostProc;
+                c->sPyramid.get_peaks(s->vPlot, pCore->nIROrigin + nIROffset, irQuery, meta::profiler_metadata::RESULT_MESH_SIZE, true);
+            }
+            pCore->sResults.publish();
+
             return STATUS_OK;
         }
 
@@ -157,19 +585,52 @@ namespace lsp
         profiler::Saver::Saver(profiler *base)
         {
             pCore       = base;
+            pResult     = NULL;
+            bCopy.store(false, std::memory_order_relaxed);
+            nOrigin     = 0;
             nIROffset   = 0;
+            fReverbTime = 0.0f;
+            fIntgLimit  = 0.0f;
+            nIndex      = 0;
+            nRate       = 0;
+            nResamplerRate  = 0;
+            fProgress   = 0.0f;
+            sTime.seconds   = 0;
+            sTime.nanos     = 0;
+            bSplit      = false;
+            nTargets    = 1 << meta::profiler_metadata::SC_SVMODE_DFL;
+            nPrimary    = meta::profiler_metadata::SC_SVMODE_DFL;
             sFile[0]    = '\0';
+            sPath[0]    = '\0';
         }
 
         profiler::Saver::~Saver()
         {
             pCore       = NULL;
+            pResult     = NULL;
             sFile[0]    = '\0';
+            sPath[0]    = '\0';
         }
 
-        void profiler::Saver::set_ir_offset(ssize_t ir_offset)
+        void profiler::Saver::set_result(const result_t *result)
         {
-            nIROffset = ir_offset;
+            // Parameters are copied since they may be changed by further post-processing
+            pResult     = result;
+            nOrigin     = result->nOrigin;
+            nIROffset   = result->nOffset;
+            fReverbTime = result->fReverbTime;
+            fIntgLimit  = result->fIntgLimit;
+        }
+
+        void profiler::Saver::set_copy(bool copy)
+        {
+            bCopy.store(copy, std::memory_order_release);
+        }
+
+        void profiler::Saver::set_targets(size_t targets, size_t primary)
+        {
+            nTargets    = targets;
+            nPrimary    = primary;
         }
 
         void profiler::Saver::set_file_name(const char *fname)
@@ -181,6 +642,20 @@ namespace lsp
             }
             else
                 sFile[0] = '\0';
+
+            // Each channel is saved to the separate WAV file if the name depends on the channel
+            bSplit      = strstr(sFile, "{channel}") != NULL;
+        }
+
+        void profiler::Saver::set_stamp(size_t index, const system::time_t *time)
+        {
+            nIndex      = index;
+            sTime       = *time;
+        }
+
+        void profiler::Saver::set_rate(size_t rate)
+        {
+            nRate       = rate;
         }
 
         bool profiler::Saver::is_file_set() const
@@ -188,124 +663,829 @@ namespace lsp
             return sFile[0] != '\0';
         }
 
-        status_t profiler::Saver::run()
+        void profiler::Saver::expand_template(char *dst, size_t index, const system::time_t *time, ssize_t channel) const
         {
-            // Doing Checks:
-            if (!pCore->bIRMeasured)
+            static const char *fields[] =
             {
-                pCore->sSaveData.enSaveStatus = STATUS_NO_DATA;
-                pCore->sSaveData.fSavePercent = 0.0f;
-                return STATUS_NO_DATA;
-            }
-
-            // Calculate saving time.
-            float fRT   = 0.0f;
-            float fIL   = 0.0f;
-            float fAll  = pCore->sSyncChirpProcessor.get_convolution_result_positive_time_length();
-
-            for (size_t ch = 0; ch < pCore->nChannels; ++ch)
+                "{index}",
+                "{date}",
+                "{time}",
+                "{channel}",
+                NULL
+            };
+
+            system::localtime_t t;
+            system::get_localtime(&t, time);
+
+            char value[32];
+            size_t len      = 0;
+            for (const char *src = sFile; (*src != '\0') && (len < (PATH_MAX - 1)); )
             {
-                if (pCore->vChannels[ch].sPostProc.fReverbTime > fRT)
-                    fRT = pCore->vChannels[ch].sPostProc.fReverbTime;
+                // Find the field at the current position
+                size_t field    = 0;
+                size_t flen     = 0;
+                if (*src == '{')
+                {
+                    for ( ; fields[field] != NULL; ++field)
+                    {
+                        flen            = strlen(fields[field]);
+                        if (!strncmp(src, fields[field], flen))
+                            break;
+                    }
+                }
+                else
+                    field           = sizeof(fields) / sizeof(const char *) - 1;
 
-                if (pCore->vChannels[ch].sPostProc.fIntgLimit > fIL)
-                    fIL = pCore->vChannels[ch].sPostProc.fIntgLimit;
+                // Format the field value
+                switch (field)
+                {
+                    case 0:
+                        snprintf(value, sizeof(value), "%04d", int(index));
+                        break;
+                    case 1:
+                        snprintf(value, sizeof(value), "%04d%02d%02d", int(t.year), int(t.month), int(t.mday));
+                        break;
+                    case 2:
+                        snprintf(value, sizeof(value), "%02d%02d%02d", int(t.hour), int(t.min), int(t.sec));
+                        break;
+                    case 3:
+                        if (channel < 0)
+                            strcpy(value, "all");
+                        else if (pCore->nChannels <= 1)
+                            strcpy(value, "mono");
+                        else
+                            strcpy(value, (channel == 0) ? "left" : "right");
+                        break;
+                    default:
+                        dst[len++]      = *(src++);
+                        continue;
+                }
+
+                // Append the field value
+                for (const char *v = value; (*v != '\0') && (len < (PATH_MAX - 1)); )
+                    dst[len++]      = *(v++);
+                src            += flen;
             }
 
-            float saveTime      = (fRT > fIL) ? fRT : fIL;
-            bool doNlinearSave  = false;
+            dst[len]        = '\0';
+        }
 
-            switch (pCore->nSaveMode)
+        void profiler::Saver::get_target_path(char *dst, size_t target, ssize_t channel) const
+        {
+            static const char *suffixes[] =
             {
-                case meta::profiler_metadata::SC_SVMODE_RT:
-                    saveTime        = fRT;
-                    break;
-                case meta::profiler_metadata::SC_SVMODE_IT:
-                    saveTime        = fIL;
-                    break;
-                case meta::profiler_metadata::SC_SVMODE_ALL:
-                    saveTime        = fAll;
-                    break;
-                case meta::profiler_metadata::SC_SVMOD_NLINEAR:
-                    doNlinearSave   = true;
-                    break;
-                case meta::profiler_metadata::SC_SVMODE_AUTO:
-                default:
-                    break;
+                "-auto.wav",
+                "-rt.wav",
+                "-coarse.wav",
+                "-all.wav",
+                ".lspc"
+            };
+
+            expand_template(dst, nIndex, &sTime, channel);
+            if ((target != nPrimary) && (target < SAVE_TARGETS))
+            {
+                // Replace the extension of the file name with the suffix of the target
+                char *ext       = strrchr(dst, '.');
+                char *sep       = strrchr(dst, FILE_SEPARATOR_C);
+                if ((ext != NULL) && ((sep == NULL) || (ext > sep)))
+                    *ext            = '\0';
+
+                size_t len      = strlen(dst);
+                strncpy(&dst[len], suffixes[target], PATH_MAX - len);
+                dst[PATH_MAX - 1] = '\0';
             }
+            if (nRate <= 0)
+                return;
 
-            saveTime            = ceilf(saveTime * 10.0f) / 10.0f; // Round to the next tenth of second
-            size_t saveCount    = dspu::seconds_to_samples(pCore->nSampleRate, saveTime); // This count is relative to the middle of the convolution result
+            // Insert the sample rate before the extension: 'ir.wav' -> 'ir-48k.wav'
+            char rate[16];
+            if (nRate % 1000)
+                snprintf(rate, sizeof(rate), "-%.1fk", nRate / 1000.0f);
+            else
+                snprintf(rate, sizeof(rate), "-%dk", int(nRate / 1000));
 
-            // Saving Data:
-            status_t returnValue;
+            size_t len      = strlen(dst);
+            char *ext       = strrchr(dst, '.');
+            char *sep       = strrchr(dst, FILE_SEPARATOR_C);
+            if ((ext == NULL) || ((sep != NULL) && (ext < sep)))
+                ext             = &dst[len];
 
-            // Update saveCount to account for offset
-            if (nIROffset > 0)
-                saveCount += size_t(nIROffset);
-            else
-                saveCount += size_t(-nIROffset);
+            size_t rlen     = strlen(rate);
+            if ((len + rlen) >= PATH_MAX)
+                return;
+            memmove(&ext[rlen], ext, strlen(ext) + 1);
+            memcpy(ext, rate, rlen);
+        }
 
-            lsp_trace("Saving %s convolution to path = %s", ((doNlinearSave) ? "nonlinear" : "linear"), sFile);
-            if (doNlinearSave)
-                returnValue = pCore->sSyncChirpProcessor.save_to_lspc(sFile, nIROffset);
-            else
-                returnValue = pCore->sSyncChirpProcessor.save_linear_convolution(sFile, nIROffset, saveCount);
-            lsp_trace("save status: %d", int(returnValue));
+        void profiler::Saver::get_capture_path(char *dst, size_t index, const system::time_t *time, const char *suffix) const
+        {
+            expand_template(dst, index, time, -1);
 
-            if (returnValue == STATUS_OK)
+            char *ext       = strrchr(dst, '.');
+            char *sep       = strrchr(dst, FILE_SEPARATOR_C);
+            if ((ext != NULL) && ((sep == NULL) || (ext > sep)))
+                *ext            = '\0';
+
+            size_t len      = strlen(dst);
+            strncpy(&dst[len], suffix, PATH_MAX - len);
+            dst[PATH_MAX - 1] = '\0';
+        }
+
+        status_t profiler::Saver::save_linear_convolution(const size_t *counts, bool resample)
+        {
+            const dspu::Sample *result = &pCore->sSavedIR;
+
+            // All WAV targets start at the same sample and differ only in length,
+            // so the whole set of files is produced in a single pass over the result
+            // Writers are allocated for CHANNELS_MAX channels per target
+            const size_t channels = lsp_min(result->channels(), size_t(CHANNELS_MAX));
+            const size_t outputs  = (bSplit) ? channels : 1;
+            const size_t rate     = (resample) ? nRate : pCore->nSampleRate;
+            ssize_t first   = lsp_limit(ssize_t(nOrigin) + nIROffset, ssize_t(0), ssize_t(pCore->nSavedLength));
+            first           = lsp_limit(first - ssize_t(pCore->nSavedFirst), ssize_t(0), ssize_t(result->length()));
+            size_t limit    = result->length() - first;
+            if (resample)
+                limit           = sResampler.output_length(limit);
+            size_t total    = 0;
+            status_t res    = STATUS_OK;
+
+            for (size_t i=0; (res == STATUS_OK) && (i<WAV_TARGETS); ++i)
             {
-                pCore->sSaveData.enSaveStatus = STATUS_OK;
-                pCore->sSaveData.fSavePercent = 100.0f;
+                if (!(nTargets & (1 << i)))
+                    continue;
+
+                size_t count    = lsp_min(counts[i], limit);
+                for (size_t j=0; j<outputs; ++j)
+                {
+                    get_target_path(sPath, i, (bSplit) ? ssize_t(j) : -1);
+                    lsp_trace("Saving linear convolution to path = %s", sPath);
+                    IRWriter *w     = &vWriters[i * CHANNELS_MAX + j];
+                    if ((res = w->open(sPath, channels / outputs, rate, count)) != STATUS_OK)
+                        break;
+                }
+                total           = lsp_max(total, count);
             }
-            else
+
+            // Allocate buffer for one interleaved chunk shared by all writers,
+            // files with one channel are written directly from the result if
+            // there is no need to resample it
+            float *buf      = NULL;
+            if ((res == STATUS_OK) && ((!bSplit) || (resample)))
             {
-                pCore->sSaveData.enSaveStatus = STATUS_UNKNOWN_ERR;
-                pCore->sSaveData.fSavePercent = 0.0f;
+                buf             = sArena.reserve(IRWriter::CHUNK_SIZE * channels);
+                if (buf == NULL)
+                    res             = STATUS_NO_MEM;
             }
 
-            return returnValue;
+            // Stream the window chunk by chunk and report the progress
+            for (size_t done = 0; (res == STATUS_OK) && (done < total); )
+            {
+                size_t to_do    = lsp_min(total - done, IRWriter::CHUNK_SIZE);
+                if (resample)
+                {
+                    // Resampled channels are interleaved, or placed one after another for split files
+                    for (size_t ch=0; ch<channels; ++ch)
+                    {
+                        float *dst      = (bSplit) ? &buf[ch * IRWriter::CHUNK_SIZE] : &buf[ch];
+                        sResampler.process(dst, (bSplit) ? 1 : channels,
+                            result->channel(ch), result->length(), first, done, to_do);
+                    }
+                }
+                else if (buf != NULL)
+                    IRWriter::interleave(buf, result, first + done, to_do);
+
+                for (size_t i=0; (res == STATUS_OK) && (i<WAV_TARGETS); ++i)
+                {
+                    size_t count    = lsp_min(counts[i], limit);
+                    for (size_t j=0; j<outputs; ++j)
+                    {
+                        IRWriter *w     = &vWriters[i * CHANNELS_MAX + j];
+                        if ((!w->opened()) || (w->written() >= count))
+                            continue;
+
+                        size_t n        = lsp_min(to_do, size_t(count - w->written()));
+                        const float *src=
+                            (!bSplit) ? buf :
+                            (resample) ? &buf[j * IRWriter::CHUNK_SIZE] :
+                            &result->channel(j)[first + done];
+                        if ((res = w->write_interleaved(src, n)) != STATUS_OK)
+                            break;
+                    }
+                }
+
+                done           += to_do;
+                fProgress       = (100.0f * done) / total;
+            }
+
+            // Close all writers, keep the first error
+            for (size_t i=0; i<WAV_TARGETS * CHANNELS_MAX; ++i)
+            {
+                status_t xres   = vWriters[i].close();
+                if (res == STATUS_OK)
+                    res             = xres;
+            }
+
+            return res;
         }
 
-        //---------------------------------------------------------------------
-        profiler::profiler(const meta::plugin_t *metadata, size_t channels): plug::Module(metadata)
+        status_t profiler::Saver::save_result()
         {
-            nChannels                   = channels;
-            vChannels                   = NULL;
+            // Doing Checks:
+            if (pResult == NULL)
+                return STATUS_NO_DATA;
 
-            sResponseData.vResponses    = NULL;
-            sResponseData.vOffsets      = NULL;
+            // Only WAV targets are written from the copy of the result, the LSPC file is written by LSPCSaver
+            if (!(nTargets & ((1 << WAV_TARGETS) - 1)))
+                return STATUS_OK;
 
-            sSaveData.enSaveStatus      = STATUS_OK;
-            sSaveData.fSavePercent      = 0.0f;
+            // The result is copied from the chirp processor only when it is saved, the next
+            // convolution waits for the copy and may overwrite the result while saving
+            const bool copy     = bCopy.load(std::memory_order_acquire);
+            dspu::Sample *ir    = (copy) ? pCore->sSyncChirpProcessor.get_convolution_result() : NULL;
+            if ((copy) && ((ir == NULL) || (ir->length() <= 0)))
+                return STATUS_NO_DATA;
 
-            nState                      = IDLE;
+            const size_t length = (copy) ? ir->length() : pCore->nSavedLength;
+            if (length <= nOrigin)
+                return STATUS_NO_DATA;
 
-            pExecutor                   = NULL;
-            pPreProcessor               = NULL;
-            pConvolver                  = NULL;
-            pPostProcessor              = NULL;
-            pSaver                      = NULL;
+            // Prepare the resampler if the IR is exported at non-native sample rate
+            const size_t srate  = pCore->nSampleRate;
+            const bool resample = (nRate > 0) && (nRate != srate);
+            if ((resample) && ((nResamplerRate != srate) || (sResampler.up() <= 0)))
+            {
+                nResamplerRate      = 0;
+                status_t res        = sResampler.init(srate, nRate);
+                if (res != STATUS_OK)
+                    return res;
+                nResamplerRate      = srate;
+            }
 
-            nSampleRate                 = 0;
+            // Calculate saving time.
+            float fRT   = fReverbTime;
+            float fIL   = fIntgLimit;
+            float fAll  = dspu::samples_to_seconds(pCore->nSampleRate, length - nOrigin);
+
+            float saveTimes[WAV_TARGETS];
+            saveTimes[meta::profiler_metadata::SC_SVMODE_AUTO]  = (fRT > fIL) ? fRT : fIL;
+            saveTimes[meta::profiler_metadata::SC_SVMODE_RT]    = fRT;
+            saveTimes[meta::profiler_metadata::SC_SVMODE_IT]    = fIL;
+            saveTimes[meta::profiler_metadata::SC_SVMODE_ALL]   = fAll;
+
+            size_t saveCounts[WAV_TARGETS];
+            size_t window       = 0;
+            for (size_t i=0; i<WAV_TARGETS; ++i)
+            {
+                float saveTime      = ceilf(saveTimes[i] * 10.0f) / 10.0f; // Round to the next tenth of second
+                saveCounts[i]       = dspu::seconds_to_samples(pCore->nSampleRate, saveTime); // This count is relative to the middle of the convolution result
+
+                // Update saveCount to account for offset
+                if (nIROffset > 0)
+                    saveCounts[i]      += size_t(nIROffset);
+                else
+                    saveCounts[i]      += size_t(-nIROffset);
+
+                if (nTargets & (1 << i))
+                    window              = lsp_max(window, saveCounts[i]);
+                if (resample)
+                    saveCounts[i]       = sResampler.output_length(saveCounts[i]);
+            }
+
+            if (copy)
+            {
+                // Only the window written to the files is copied. The margin of the longest resampler
+                // filter is kept around the window, so savers at other sample rates can share the copy
+                const size_t margin = PolyphaseResampler::TAPS_MAX;
+                const size_t first  = lsp_limit(ssize_t(nOrigin) + nIROffset, ssize_t(0), ssize_t(length));
+                const size_t head   = lsp_min(first, margin);
+                const size_t count  = lsp_min(length - first, window + margin);
+
+                status_t res        = store_result(&pCore->sSavedIR, ir, first - head, head + count);
+                pCore->nSavedFirst  = (res == STATUS_OK) ? first - head : 0;
+                pCore->nSavedLength = (res == STATUS_OK) ? length : 0;
+                if (res != STATUS_OK)
+                    pCore->sSavedIR.set_length(0);
+                bCopy.store(false, std::memory_order_release);
+                if (res != STATUS_OK)
+                    return res;
+            }
+
+            return save_linear_convolution(saveCounts, resample);
+        }
+
+        status_t profiler::Saver::run()
+        {
+            fProgress   = 0.0f;
+            status_t returnValue = save_result();
+            lsp_trace("save status: %d", int(returnValue));
+
+            // The copy is not made on error, the convolution and other savers should not wait for it
+            if (bCopy.load(std::memory_order_acquire))
+            {
+                pCore->sSavedIR.set_length(0);
+                pCore->nSavedFirst  = 0;
+                pCore->nSavedLength = 0;
+                bCopy.store(false, std::memory_order_release);
+            }
+            if (returnValue == STATUS_OK)
+                fProgress       = 100.0f;
+
+            return returnValue;
+        }
+
+        //---------------------------------------------------------------------
+        profiler::LSPCSaver::LSPCSaver(profiler *base)
+        {
+            pCore       = base;
+            nArchive    = meta::profiler_metadata::SC_ARCHIVE_DFL;
+            sPath[0]    = '\0';
+        }
+
+        profiler::LSPCSaver::~LSPCSaver()
+        {
+            pCore       = NULL;
+            sPath[0]    = '\0';
+        }
+
+        status_t profiler::LSPCSaver::run()
+        {
+            if (!pCore->bIRMeasured)
+                return STATUS_NO_DATA;
+
+            // The saver does not change the file name and offset while this task is running
+            Saver *saver    = pCore->pSaver;
+            saver->get_target_path(sPath, meta::profiler_metadata::SC_SVMOD_NLINEAR, -1);
+
+            lsp_trace("Saving nonlinear convolution to path = %s", sPath);
+            status_t returnValue = pCore->sSyncChirpProcessor.save_to_lspc(sPath, saver->get_ir_offset());
+            lsp_trace("save status: %d", int(returnValue));
+
+            if ((returnValue == STATUS_OK) && (nArchive != meta::profiler_metadata::SC_ARCHIVE_OFF))
+            {
+                returnValue     = write_archive();
+                lsp_trace("archive status: %d", int(returnValue));
+            }
+
+            return returnValue;
+        }
+
+        void profiler::LSPCSaver::set_archive(size_t mode)
+        {
+            nArchive    = mode;
+        }
+
+        status_t profiler::LSPCSaver::write_archive()
+        {
+            dspu::SyncChirpProcessor *scp   = &pCore->sSyncChirpProcessor;
+            const dspu::Sample *result      = scp->get_convolution_result();
+            if ((result == NULL) || (result->length() <= 0))
+                return STATUS_NO_DATA;
+
+            // The archive is written next to the LSPC file
+            char *ext       = strrchr(sPath, '.');
+            char *sep       = strrchr(sPath, FILE_SEPARATOR_C);
+            if ((ext != NULL) && ((sep == NULL) || (ext > sep)))
+                *ext            = '\0';
+            size_t len      = strlen(sPath);
+            if ((len + 5) >= PATH_MAX)
+                return STATUS_OVERFLOW;
+            strcpy(&sPath[len], ".lspx");
+
+            // Harmonic IRs of the synchronized chirp precede the linear IR by L*ln(k) seconds,
+            // each segment spans half of the distance to the neighbour harmonics
+            const size_t channels   = lsp_min(result->channels(), pCore->nChannels);
+            const ssize_t length    = result->length();
+            const ssize_t origin    = length >> 1;
+            const double f1         = scp->get_chirp_initial_frequency();
+            const double f2         = scp->get_chirp_final_frequency();
+            const double rate       = scp->get_chirp_duration_seconds() * pCore->nSampleRate / log(f2 / f1);
+
+            ssize_t bounds[ARCHIVE_HARMONICS + 1];
+            size_t harmonics        = 0;
+            bounds[0]               = length;
+            for (size_t k=1; k<=ARCHIVE_HARMONICS; ++k)
+            {
+                ssize_t lo              = origin - ssize_t(0.5 * rate * (log(double(k)) + log(double(k + 1))));
+                lo                      = lsp_max(lo, ssize_t(0));
+                if (lo >= bounds[k-1])
+                    break;
+                bounds[k]               = lo;
+                harmonics               = k;
+            }
+
+            status_t res    = sArchive.create(sPath, nArchive == meta::profiler_metadata::SC_ARCHIVE_COMPRESSED);
+            if (res != STATUS_OK)
+                return res;
+
+            // Metadata
+            IndexedArchive::meta_t m;
+            m.sample_rate   = pCore->nSampleRate;
+            m.channels      = channels;
+            m.harmonics     = harmonics;
+            m.ir_offset     = pCore->pSaver->get_ir_offset();
+            m.initial_freq  = f1;
+            m.final_freq    = f2;
+            m.duration      = scp->get_chirp_duration_seconds();
+            m.alpha         = scp->get_chirp_alpha();
+            m.gamma         = scp->get_chirp_gamma();
+            res             = sArchive.write(IndexedArchive::CT_META, 0, 0, 0, &m, sizeof(m) / sizeof(uint32_t));
+
+            for (size_t ch=0; (res == STATUS_OK) && (ch<channels); ++ch)
+            {
+                channel_t *c    = &pCore->vChannels[ch];
+
+                IndexedArchive::channel_meta_t cm;
+                cm.latency      = c->nLatency;
+                cm.rt_accurate  = (c->sPostProc.bRTAccuray) ? 1 : 0;
+                cm.reverb_time  = c->sPostProc.fReverbTime;
+                cm.correlation  = c->sPostProc.fCorrCoeff;
+                cm.intg_limit   = c->sPostProc.fIntgLimit;
+                cm.reserved     = 0.0f;
+                res             = sArchive.write(IndexedArchive::CT_CHANNEL, ch, 0, 0, &cm, sizeof(cm) / sizeof(uint32_t));
+
+                // The capture does not belong to the loaded measurement
+                dspu::Sample *cap   = c->sResponseTaker.get_capture();
+                if ((res == STATUS_OK) && (!pCore->bChirpLoaded) && (cap != NULL) && (cap->length() > 0))
+                    res             = sArchive.write(IndexedArchive::CT_CAPTURE, ch, 0,
+                        c->sResponseTaker.get_capture_start(), cap->channel(0), cap->length());
+
+                const float *ir     = result->channel(ch);
+                for (size_t k=1; (res == STATUS_OK) && (k<=harmonics); ++k)
+                    res             = sArchive.write(IndexedArchive::CT_IR, ch, k,
+                        bounds[k] - origin, &ir[bounds[k]], bounds[k-1] - bounds[k]);
+            }
+
+            status_t xres   = sArchive.close();
+            return (res == STATUS_OK) ? xres : res;
+        }
+
+        //---------------------------------------------------------------------
+        profiler::ChirpSaver::ChirpSaver(profiler *base)
+        {
+            pCore       = base;
+            sPath[0]    = '\0';
+        }
+
+        profiler::ChirpSaver::~ChirpSaver()
+        {
+            pCore       = NULL;
+        }
+
+        void profiler::ChirpSaver::set_file_name(const char *fname)
+        {
+            strncpy(sPath, fname, PATH_MAX);
+            sPath[PATH_MAX - 1] = '\0';
+        }
+
+        status_t profiler::ChirpSaver::run()
+        {
+            // Generate the chirp for current settings, exactly as for the measurement
+            status_t res = pCore->sSyncChirpProcessor.reconfigure();
+            if (res != STATUS_OK)
+                return res;
+
+            dspu::Sample *chirp = pCore->sSyncChirpProcessor.get_chirp();
+            if ((chirp == NULL) || (chirp->length() <= 0))
+                return STATUS_NO_DATA;
+
+            lsp_trace("Saving chirp to path = %s", sPath);
+            if ((res = sWriter.open(sPath, chirp->channels(), pCore->nSampleRate, chirp->length())) != STATUS_OK)
+                return res;
+
+            res             = sWriter.write(chirp, 0, chirp->length());
+            status_t xres   = sWriter.close();
+            return (res == STATUS_OK) ? xres : res;
+        }
+
+        //---------------------------------------------------------------------
+        profiler::LongSweeper::LongSweeper()
+        {
+            enOp        = OP_EXPORT;
+            sPath[0]    = '\0';
+        }
+
+        profiler::LongSweeper::~LongSweeper()
+        {
+        }
+
+        status_t profiler::LongSweeper::configure(op_t op, const char *fname, size_t sample_rate, float duration, float amplitude)
+        {
+            enOp        = op;
+            set_file_name(fname);
+
+            return sSweep.init(sample_rate, SYNC_CHIRP_START_FREQ, SYNC_CHIRP_MAX_FREQ, duration, amplitude);
+        }
+
+        void profiler::LongSweeper::set_file_name(const char *fname)
+        {
+            strncpy(sPath, fname, PATH_MAX);
+            sPath[PATH_MAX - 1] = '\0';
+        }
+
+        status_t profiler::LongSweeper::run()
+        {
+            if (enOp == OP_EXPORT)
+            {
+                lsp_trace("Saving long sweep chirp to path = %s", sPath);
+                return sSweep.export_chirp(sPath);
+            }
+
+            // The impulse response is saved next to the response file
+            char ir[PATH_MAX];
+            strncpy(ir, sPath, PATH_MAX);
+            ir[PATH_MAX - 1] = '\0';
+
+            char *ext       = strrchr(ir, '.');
+            char *sep       = strrchr(ir, FILE_SEPARATOR_C);
+            if ((ext != NULL) && ((sep == NULL) || (ext > sep)))
+                *ext            = '\0';
+
+            size_t len      = strlen(ir);
+            strncpy(&ir[len], "-ir.wav", PATH_MAX - len);
+            ir[PATH_MAX - 1] = '\0';
+
+            lsp_trace("Deconvolving long sweep response from path = %s", sPath);
+            return sSweep.deconvolve(sPath, ir);
+        }
+
+        //---------------------------------------------------------------------
+        profiler::CaptureArchiver::CaptureArchiver(profiler *base)
+        {
+            pCore       = base;
+            nIndex      = 0;
+            sTime.seconds   = 0;
+            sTime.nanos     = 0;
+            pSuffix     = NULL;
+            nState      = AS_IDLE;
+            nCode       = STATUS_OK;
+            bStarted    = false;
+            sPath[0]    = '\0';
+            vBuffer     = NULL;
+            pData       = NULL;
+        }
+
+        profiler::CaptureArchiver::~CaptureArchiver()
+        {
+            stop();
+            sWriter.close();
+            free_aligned(pData);
+            vBuffer     = NULL;
+            pCore       = NULL;
+        }
+
+        status_t profiler::CaptureArchiver::launch()
+        {
+            if (bStarted)
+                return STATUS_OK;
+
+            if (vBuffer == NULL)
+            {
+                vBuffer         = alloc_aligned<float>(pData, IRWriter::CHUNK_SIZE * CHANNELS_MAX);
+                if (vBuffer == NULL)
+                    return STATUS_NO_MEM;
+            }
+
+            status_t res    = start();
+            if (res == STATUS_OK)
+                bStarted        = true;
+            return res;
+        }
+
+        void profiler::CaptureArchiver::stop()
+        {
+            if (!bStarted)
+                return;
+
+            cancel();
+            sWakeup.post();
+            join();
+            bStarted    = false;
+        }
+
+        bool profiler::CaptureArchiver::begin(size_t index, const system::time_t *time, const char *suffix)
+        {
+            if ((!bStarted) || (atomic_load(&nState) != AS_IDLE))
+                return false;
+
+            // The stamp is published to the thread by the state change
+            nIndex      = index;
+            sTime       = *time;
+            pSuffix     = suffix;
+            nCode       = STATUS_OK;
+            atomic_store(&nState, uatomic_t(AS_RECORDING));
+            return true;
+        }
+
+        void profiler::CaptureArchiver::finish()
+        {
+            // The thread may have already stopped archiving due to an error
+            atomic_cas(&nState, uatomic_t(AS_RECORDING), uatomic_t(AS_FINISH));
+        }
+
+        bool profiler::CaptureArchiver::done(status_t *code)
+        {
+            if (atomic_load(&nState) != AS_DONE)
+                return false;
+
+            *code       = nCode;
+            atomic_store(&nState, uatomic_t(AS_IDLE));
+            return true;
+        }
+
+        void profiler::CaptureArchiver::drain()
+        {
+            uatomic_t state     = atomic_load(&nState);
+            if ((state != AS_RECORDING) && (state != AS_FINISH))
+                return;
+
+            RingBuffer *ring    = &pCore->sCaptureRing;
+            status_t res        = STATUS_OK;
+
+            // The file is opened on the first drain of the capture
+            if (!sWriter.opened())
+            {
+                pCore->pSaver->get_capture_path(sPath, nIndex, &sTime, pSuffix);
+                lsp_trace("Archiving raw capture to path = %s", sPath);
+                res                 = sWriter.open(sPath, ring->channels(), pCore->nSampleRate, 0);
+            }
+
+            // Drain everything the audio thread has written to the ring
+            while (res == STATUS_OK)
+            {
+                size_t n        = ring->read(vBuffer, IRWriter::CHUNK_SIZE);
+                if (n <= 0)
+                    break;
+                res             = sWriter.write_interleaved(vBuffer, n);
+            }
+
+            // The ring has been drained after the finish request, so the capture is complete
+            if ((res != STATUS_OK) || (state == AS_FINISH))
+            {
+                status_t xres   = sWriter.close();
+                if (res == STATUS_OK)
+                    res             = xres;
+
+                nCode           = res;
+                atomic_store(&nState, uatomic_t(AS_DONE));
+            }
+        }
+
+        status_t profiler::CaptureArchiver::run()
+        {
+            while (!is_cancelled())
+            {
+                drain();
+                sWakeup.wait(DRAIN_PERIOD);
+            }
+
+            return STATUS_OK;
+        }
+
+        //---------------------------------------------------------------------
+        profiler::Analyzer::Analyzer(profiler *base)
+        {
+            pCore       = base;
+            nTile       = 0;
+        }
+
+        profiler::Analyzer::~Analyzer()
+        {
+            pCore       = NULL;
+            nTile       = 0;
+        }
+
+        void profiler::Analyzer::set_tile(size_t tile)
+        {
+            nTile = tile;
+        }
+
+        status_t profiler::Analyzer::run()
+        {
+            size_t ch       = nTile / ANALYSIS_TILES;
+            size_t part     = nTile % ANALYSIS_TILES;
+            if (ch >= pCore->nChannels)
+                return STATUS_BAD_STATE;
+
+            dspu::Sample *result = pCore->sSyncChirpProcessor.get_convolution_result();
+            if ((result == NULL) || (result->length() <= 0))
+                return STATUS_NO_DATA;
+
+            // Analyse the same range as the result plot shows
+            channel_t *c    = &pCore->vChannels[ch];
+            ssize_t offset  = pCore->pPostProcessor->get_ir_offset();
+            ssize_t first   = lsp_limit(ssize_t(pCore->nIROrigin) + offset, ssize_t(0), ssize_t(result->length()));
+            size_t count    = (offset > 0) ? c->sPostProc.nReverbTime : c->sPostProc.nReverbTime + size_t(-offset);
+            count           = lsp_min(count, result->length() - first);
+
+            const float *ir     = &result->channel(ch)[first];
+            DecayAnalyzer *da   = &pCore->sDecayAnalyzer;
+
+            // The first tile of the channel is the Energy Time Curve,
+            // it also computes the reference level for the spectral decay
+            if (part == 0)
+            {
+                da->energy_time_curve(c->vETC, meta::profiler_metadata::ETC_MESH_SIZE, ir, count, meta::profiler_metadata::ETC_FLOOR);
+                c->fCSDReference    = da->spectrum(ir, count);
+                return STATUS_OK;
+            }
+
+            // Other tiles compute slices of the Cumulative Spectral Decay spread over the first FFT frame
+            size_t span     = lsp_min(count, da->fft_size());
+            size_t slice    = (part - 1) * CSD_TILE_SLICES;
+            float *row      = pCore->vCSDRows;
+
+            for (size_t i=0; i<CSD_TILE_SLICES; ++i, ++slice)
+            {
+                size_t start    = (span * slice) / meta::profiler_metadata::CSD_SLICES;
+                da->spectrum(&ir[start], count - start);
+                da->map_spectrum(
+                    row, meta::profiler_metadata::CSD_MESH_SIZE, pCore->nSampleRate,
+                    meta::profiler_metadata::FREQUENCY_MIN, meta::profiler_metadata::FREQUENCY_MAX,
+                    c->fCSDReference, meta::profiler_metadata::CSD_RANGE);
+                row            += meta::profiler_metadata::CSD_MESH_SIZE;
+            }
+
+            return STATUS_OK;
+        }
+
+        //---------------------------------------------------------------------
+        profiler::profiler(const meta::plugin_t *metadata, size_t channels): plug::Module(metadata)
+        {
+            nChannels                   = channels;
+            vChannels                   = NULL;
+
+            sResponseData.vResponses    = NULL;
+            sResponseData.vOffsets      = NULL;
+
+            sSaveData.enSaveStatus      = STATUS_OK;
+            sSaveData.fSavePercent      = 0.0f;
+
+            nState                      = IDLE;
+
+            pExecutor                   = NULL;
+            pPoolStarter                = NULL;
+            pTuner                      = NULL;
+            bWorkerPool                 = false;
+            bPoolStarted                = false;
+            pPreparer                   = NULL;
+            bPrepared                   = false;
+            pPreProcessor               = NULL;
+            pConvolver                  = NULL;
+            pPostProcessor              = NULL;
+            pSaver                      = NULL;
+            for (size_t i=0; i<EXPORT_RATES; ++i)
+                vRateSavers[i]              = NULL;
+            pLSPCSaver                  = NULL;
+            pChirpSaver                 = NULL;
+            pLongSweeper                = NULL;
+            pCaptureArchiver            = NULL;
+            bCaptureArchiving           = false;
+            nCaptureOverrun             = 0;
+            nLongOffset                 = 0;
+            nLongLength                 = 0;
+            nLongOverrun                = 0;
+            bLongCapture                = false;
+            pAnalyzer                   = NULL;
+
+            nAnalysisTile               = 0;
+            vCSDRows                    = NULL;
+
+            nSampleRate                 = 0;
+            nIROrigin                   = 0;
             fLtAmplitude                = 1.0f;
             nWaitCounter                = 0;
             bDoLatencyOnly              = false;
 
             fScpDurationPrevious        = 0.0f;
+            nChirpQuality               = meta::profiler_metadata::SC_QUALITY_DFL;
             bIRMeasured                 = false;
+            nResultFront                = 0;
+            nResultBack                 = 0;
+            bResultPending              = false;
+            nSaveIndex                  = 1;
+            nRatesPending               = 0;
+            nSavedFirst                 = 0;
+            nSavedLength                = 0;
+            bAutoSavePending            = false;
+            bChirpLoaded                = false;
+            bChirpPending               = false;
             nSaveMode                   = meta::profiler_metadata::SC_SVMODE_DFL;
+            nSaveTargets                = 1 << meta::profiler_metadata::SC_SVMODE_DFL;
+            nExportRates                = 0;
 
             nTriggers                   = 0;
 
             vTempBuffer                 = NULL;
             vDisplayAbscissa            = NULL;
-            vDisplayOrdinate            = NULL;
+            pIDisplay                   = NULL;
+            nIDisplayWidth              = 0;
+            nIDisplayHeight             = 0;
             pData                       = NULL;
 
             pBypass                     = NULL;
 
             pStateLEDs                  = NULL;
+            pWorkerPool                 = NULL;
 
             pCalFrequency               = NULL;
             pCalAmplitude               = NULL;
@@ -320,150 +1500,869 @@ namespace lsp
 
             pDuration                   = NULL;
             pActualDuration             = NULL;
+            pChirpQuality               = NULL;
+            pPreprocTime                = NULL;
             pLinTrigger                 = NULL;
 
-            pIROffset                   = NULL;
-            pRTAlgoSelector             = NULL;
-            pPostTrigger                = NULL;
+            pIROffset                   = NULL;
+            pIRAutoOffset               = NULL;
+            pIROffsetMeter              = NULL;
+            pRTAlgoSelector             = NULL;
+            pPostTrigger                = NULL;
+
+            pSaveModeSelector           = NULL;
+            for (size_t i=0; i<SAVE_TARGETS; ++i)
+                vSaveTargets[i]             = NULL;
+            for (size_t i=0; i<EXPORT_RATES; ++i)
+                vExportRates[i]             = NULL;
+            pIRFileName                 = NULL;
+            pIRSaveCmd                  = NULL;
+            pIRSaveStatus               = NULL;
+            pIRSavePercent              = NULL;
+            pAutoSave                   = NULL;
+            pIRLoadFile                 = NULL;
+            pIRLoadStatus               = NULL;
+            pArchiveMode                = NULL;
+            pChirpFile                  = NULL;
+            pChirpCmd                   = NULL;
+            pChirpStatus                = NULL;
+            pResponseFile               = NULL;
+            pResponseStatus             = NULL;
+            pLongDuration               = NULL;
+            pLongChirpFile              = NULL;
+            pLongChirpCmd               = NULL;
+            pLongChirpStatus            = NULL;
+            pLongResponseFile           = NULL;
+            pLongResponseStatus         = NULL;
+            pLongMeasureCmd             = NULL;
+            pLongMeasureStatus          = NULL;
+            pCaptureSwitch              = NULL;
+            pCaptureStatus              = NULL;
+        }
+
+        profiler::~profiler()
+        {
+            do_destroy();
+        }
+
+        void profiler::destroy()
+        {
+            plug::Module::destroy();
+            do_destroy();
+        }
+
+        void profiler::do_destroy()
+        {
+            // Threads of the worker pool should finish before tasks are deleted
+            sWorkerPool.shutdown();
+            if (pPoolStarter != NULL)
+            {
+                delete pPoolStarter;
+                pPoolStarter = NULL;
+            }
+
+            if (pTuner != NULL)
+            {
+                delete pTuner;
+                pTuner = NULL;
+            }
+
+            if (pPreparer != NULL)
+            {
+                delete pPreparer;
+                pPreparer = NULL;
+            }
+
+            if (pPreProcessor != NULL)
+            {
+                delete pPreProcessor;
+                pPreProcessor = NULL;
+            }
+
+            if (pConvolver != NULL)
+            {
+                delete pConvolver;
+                pConvolver = NULL;
+            }
+
+            if (pPostProcessor != NULL)
+            {
+                delete pPostProcessor;
+                pPostProcessor = NULL;
+            }
+
+            if (pSaver != NULL)
+            {
+                delete pSaver;
+                pSaver = NULL;
+            }
+
+            for (size_t i=0; i<EXPORT_RATES; ++i)
+            {
+                if (vRateSavers[i] != NULL)
+                {
+                    delete vRateSavers[i];
+                    vRateSavers[i] = NULL;
+                }
+            }
+
+            if (pLSPCSaver != NULL)
+            {
+                delete pLSPCSaver;
+                pLSPCSaver = NULL;
+            }
+
+            if (pChirpSaver != NULL)
+            {
+                delete pChirpSaver;
+                pChirpSaver = NULL;
+            }
+
+            if (pLongSweeper != NULL)
+            {
+                delete pLongSweeper;
+                pLongSweeper = NULL;
+            }
+
+            if (pCaptureArchiver != NULL)
+            {
+                delete pCaptureArchiver;
+                pCaptureArchiver = NULL;
+            }
+            sCaptureRing.destroy();
+
+            if (pAnalyzer != NULL)
+            {
+                delete pAnalyzer;
+                pAnalyzer = NULL;
+            }
+
+            if (sResponseData.vResponses != NULL)
+            {
+                for (size_t ch = 0; ch < nChannels; ++ch)
+                {
+                    dspu::Sample *s = sResponseData.vResponses[ch];
+                    if (s != NULL)
+                        s->destroy();
+                }
+
+                delete[] sResponseData.vResponses;
+                sResponseData.vResponses = NULL;
+            }
+
+            free_aligned(sResponseData.pData);
+            sResponseData.pData     = NULL;
+            sResponseData.vOffsets  = NULL;
+
+            if (pIDisplay != NULL)
+            {
+                pIDisplay->destroy();
+                pIDisplay               = NULL;
+            }
+
+            free_aligned(pData);
+            pData                   = NULL;
+            vTempBuffer             = NULL;
+            vDisplayAbscissa        = NULL;
+            vCSDRows                = NULL;
+
+            if (vChannels != NULL)
+            {
+                for (size_t ch = 0; ch < nChannels; ++ch)
+                {
+                    channel_t *c = &vChannels[ch];
+                    c->sLatencyDetector.destroy();
+                    c->sResponseTaker.destroy();
+                    c->sPyramid.destroy();
+                    c->sFileResponse.destroy();
+                    c->vBuffer = NULL;
+                    c->vETC    = NULL;
+                }
+                delete [] vChannels;
+                vChannels = NULL;
+            }
+
+            sSyncChirpProcessor.destroy();
+            sCalOscillator.destroy();
+            sDecayAnalyzer.destroy();
+            sSavedIR.destroy();
+        }
+
+        void profiler::update_pre_processing_info()
+        {
+            pActualDuration->set_value(sSyncChirpProcessor.get_chirp_duration_seconds());
+
+            for (size_t ch = 0; ch < nChannels; ++ch)
+            {
+                vChannels[ch].sResponseTaker.set_op_tail(sSyncChirpProcessor.get_chirp_duration_seconds());
+            }
+        }
+
+        void profiler::update_post_processing_info()
+        {
+            // Take the latest snapshot of post-processing results if there is any
+            if (sResults.fetch())
+            {
+                size_t slot = sResults.front();
+                for (size_t ch = 0; ch < nChannels; ++ch)
+                {
+                    channel_t *c            = &vChannels[ch];
+                    const postproc_t *pp    = &c->vSnapshots[slot].sPostProc;
+
+                    c->pRTScreen->set_value(pp->fReverbTime);
+                    c->pRScreen->set_value(pp->fCorrCoeff);
+                    c->pILScreen->set_value(pp->fIntgLimit);
+                    c->pRTAccuracyLed->set_value((pp->bRTAccuray) ? 1.0f : 0.0f);
+                    c->bPlotPending         = true;
+
+                    // The inline display is drawn by another thread, it gets its own copy of the snapshot
+                    snapshot_t *ds          = &c->vDisplay[sDisplay.back()];
+                    ds->sPostProc           = *pp;
+                    dsp::copy(ds->vPlot, c->vSnapshots[slot].vPlot, meta::profiler_metadata::RESULT_MESH_SIZE);
+                }
+                sDisplay.publish();
+
+                if (pWrapper != NULL)
+                    pWrapper->query_display_draw();
+            }
+
+            // Commit the plots as soon as the UI consumes the previous meshes
+            const size_t slot = sResults.front();
+            for (size_t ch = 0; ch < nChannels; ++ch)
+            {
+                channel_t *c = &vChannels[ch];
+                if (!c->bPlotPending)
+                    continue;
+
+                plug::mesh_t *mesh = c->pResultMesh->buffer<plug::mesh_t>();
+                if (mesh != NULL)
+                {
+                    if (!mesh->isEmpty())
+                        continue;
+
+                    dsp::copy(mesh->pvData[0], vDisplayAbscissa, meta::profiler_metadata::RESULT_MESH_SIZE);
+                    dsp::copy(mesh->pvData[1], c->vSnapshots[slot].vPlot, meta::profiler_metadata::RESULT_MESH_SIZE);
+                    mesh->data(2, meta::profiler_metadata::RESULT_MESH_SIZE);
+                }
+
+                c->bPlotPending = false;
+            }
+        }
+
+        void profiler::update_saving_info()
+        {
+            pIRSaveStatus->set_value(sSaveData.enSaveStatus);
+            pIRSavePercent->set_value(sSaveData.fSavePercent);
+        }
+
+        void profiler::commit_result()
+        {
+            // New convolution result becomes the front one only when it is post-processed
+            if (bResultPending)
+            {
+                nResultFront    = nResultBack;
+                bResultPending  = false;
+                if (pAutoSave->value() >= 0.5f)
+                    bAutoSavePending    = true;
+            }
+
+            result_t *r     = &vResults[nResultFront];
+            dspu::Sample *ir = sSyncChirpProcessor.get_convolution_result();
+            if ((ir == NULL) || (ir->length() <= 0))
+                return;
+
+            r->nOrigin      = nIROrigin;
+            r->nOffset      = pPostProcessor->get_ir_offset();
+            r->fReverbTime  = 0.0f;
+            r->fIntgLimit   = 0.0f;
+            for (size_t ch = 0; ch < nChannels; ++ch)
+            {
+                r->fReverbTime  = lsp_max(r->fReverbTime, vChannels[ch].sPostProc.fReverbTime);
+                r->fIntgLimit   = lsp_max(r->fIntgLimit, vChannels[ch].sPostProc.fIntgLimit);
+            }
+            r->bValid       = true;
+        }
+
+        void profiler::configure_chirp()
+        {
+            // Draft quality synthesizes the chirp directly at the sample rate, other qualities
+            // synthesize the band-limited chirp with the oversampler of the different order
+            switch (nChirpQuality)
+            {
+                case meta::profiler_metadata::SC_QUALITY_DRAFT:
+                    sSyncChirpProcessor.set_chirp_synthesis_method(dspu::SCP_SYNTH_SIMPLE);
+                    sSyncChirpProcessor.set_oversampler_mode(dspu::OM_NONE);
+                    break;
+                case meta::profiler_metadata::SC_QUALITY_STANDARD:
+                    sSyncChirpProcessor.set_chirp_synthesis_method(dspu::SCP_SYNTH_BANDLIMITED);
+                    sSyncChirpProcessor.set_oversampler_mode(dspu::OM_LANCZOS_2X2);
+                    break;
+                case meta::profiler_metadata::SC_QUALITY_REFERENCE:
+                default:
+                    sSyncChirpProcessor.set_chirp_synthesis_method(dspu::SCP_SYNTH_BANDLIMITED);
+                    sSyncChirpProcessor.set_oversampler_mode(dspu::OM_LANCZOS_8X2);
+                    break;
+            }
+
+            sSyncChirpProcessor.set_chirp_initial_frequency(SYNC_CHIRP_START_FREQ);
+            sSyncChirpProcessor.set_chirp_final_frequency(SYNC_CHIRP_MAX_FREQ);
+            sSyncChirpProcessor.set_fader_fading_method(dspu::SCP_FADE_RAISED_COSINES);
+            sSyncChirpProcessor.set_fader_fadein(0.500f);
+            sSyncChirpProcessor.set_fader_fadeout(0.020f);
+        }
+
+        void profiler::restore_chirp()
+        {
+            // Restore the chirp settings replaced by the loaded measurement
+            if (!bChirpLoaded)
+                return;
+
+            configure_chirp();
+            sSyncChirpProcessor.set_sample_rate(nSampleRate);
+            sSyncChirpProcessor.set_chirp_duration(pDuration->value());
+            sSyncChirpProcessor.set_chirp_amplitude(fLtAmplitude);
+            bChirpLoaded    = false;
+        }
+
+        void profiler::commit_chirp()
+        {
+            // LSPC file is written from the state of the chirp processor, the settings are applied after saving
+            if (lspc_saving())
+            {
+                bChirpPending   = true;
+                return;
+            }
+            bChirpPending   = false;
+
+            sSyncChirpProcessor.set_chirp_duration(pDuration->value());
+            sSyncChirpProcessor.set_chirp_amplitude(fLtAmplitude);
+
+            // The chirp of the loaded measurement is replaced by the new quality on restore
+            size_t quality  = pChirpQuality->value();
+            if (quality != nChirpQuality)
+            {
+                nChirpQuality   = quality;
+                if (!bChirpLoaded)
+                    configure_chirp();
+            }
+
+            // Pending settings are applied after preparation
+            if ((bPrepared) && (sSyncChirpProcessor.needs_update()))
+                sSyncChirpProcessor.update_settings();
+        }
+
+        bool profiler::prepare_on_demand()
+        {
+            if (bPrepared)
+                return true;
+
+            // The Preparer task is submitted by the state machine
+            if (nState == IDLE)
+                nState      = PREPARING;
+            return false;
+        }
+
+        void profiler::start_loading(plug::IPort *file, plug::IPort *status, Convolver::source_t source)
+        {
+            plug::path_t *path = (file != NULL) ? file->buffer<plug::path_t>() : NULL;
+            if ((path == NULL) || (!path->pending()))
+                return;
+
+            // The chirp processor is replaced by the loaded state, it should not be in use
+            if ((nState != IDLE) || (!pConvolver->idle()) || (lspc_saving()) || (chirp_exporting()))
+                return;
+            if (!prepare_on_demand())
+                return;
+
+            path->accept();
+            const char *fname = path->path();
+            if ((fname == NULL) || (fname[0] == '\0'))
+            {
+                path->commit();
+                return;
+            }
+
+            // The loaded result passes the same way as the result of the measurement,
+            // the recorded response is deconvolved with the chirp for current settings
+            lsp_trace("load file %s", fname);
+            if (source == Convolver::SRC_RESPONSE)
+                restore_chirp();
+            pConvolver->set_source(source, fname);
+            status->set_value(STATUS_LOADING);
+            nState          = CONVOLVING;
+        }
+
+        void profiler::start_capture_archive()
+        {
+            if ((pCaptureSwitch->value() < 0.5f) || (bCaptureArchiving))
+                return;
+            if ((!pCaptureArchiver->started()) || (!pCaptureArchiver->idle()) ||
+                (sCaptureRing.is_empty()) || (!pSaver->is_file_set()))
+            {
+                pCaptureStatus->set_value(STATUS_BAD_STATE);
+                return;
+            }
+
+            // The capture gets the index the result of this measurement gets when saved
+            system::time_t time;
+            system::get_time(&time);
+
+            // The ring is not accessed by the idle drain thread
+            sCaptureRing.clear();
+            nCaptureOverrun     = 0;
+            bCaptureArchiving   = pCaptureArchiver->begin(nSaveIndex, &time, "-capture.wav");
+            pCaptureStatus->set_value((bCaptureArchiving) ? STATUS_IN_PROCESS : STATUS_BAD_STATE);
+        }
+
+        bool profiler::submit_task(ipc::ITask *task)
+        {
+            // Tasks that can not be queued to the worker pool immediately are passed to the host
+            if ((bWorkerPool) && (bPoolStarted) && (sWorkerPool.submit(task)))
+                return true;
+            return pExecutor->submit(task);
+        }
+
+        void profiler::update_worker_pool()
+        {
+            // Threads are started once on the first request, the failure is not retried
+            if ((!bWorkerPool) || (bPoolStarted))
+                return;
+
+            if (pPoolStarter->idle())
+                pExecutor->submit(pPoolStarter);
+            else if (pPoolStarter->completed())
+                bPoolStarted    = pPoolStarter->successful();
+        }
+
+        void profiler::update_tuner()
+        {
+            // The costs are measured once, in IDLE state to not to delay the first measurement
+            if ((pTuner->idle()) && (nState == IDLE))
+                submit_task(pTuner);
+        }
+
+        void profiler::update_capture_archive()
+        {
+            if (!bCaptureArchiving)
+                return;
+
+            nCaptureOverrun    += sCaptureRing.take_overrun();
+
+            status_t res;
+            if (pCaptureArchiver->done(&res))
+            {
+                // Frames dropped by the ring are reported to the user
+                if ((res == STATUS_OK) && (nCaptureOverrun > 0))
+                    res                 = STATUS_OVERFLOW;
+                pCaptureStatus->set_value(res);
+                bCaptureArchiving   = false;
+                return;
+            }
+
+            // The drain thread closes the file after the rest of the ring when the recording is over
+            if (nState != RECORDING)
+                pCaptureArchiver->finish();
+        }
+
+        bool profiler::chirp_exporting()
+        {
+            return (pChirpSaver->submitted()) || (pChirpSaver->started());
+        }
+
+        void profiler::update_chirp_export()
+        {
+            if (pChirpSaver->completed())
+            {
+                pChirpStatus->set_value(pChirpSaver->code());
+                pChirpSaver->reset();
+            }
+
+            // The chirp is exported when the chirp processor is not in use
+            if ((pChirpCmd->value() < 0.5f) || (!pChirpSaver->idle()) || (!pAnalyzer->idle()))
+                return;
+            if (!prepare_on_demand())
+                return;
+
+            plug::path_t *path = pChirpFile->buffer<plug::path_t>();
+            if ((path == NULL) || (path->path()[0] == '\0') ||
+                (nState != IDLE) || (!pConvolver->idle()) || (lspc_saving()))
+            {
+                pChirpStatus->set_value(STATUS_BAD_STATE);
+                return;
+            }
+
+            restore_chirp();
+            pChirpSaver->set_file_name(path->path());
+            pChirpStatus->set_value(STATUS_LOADING);
+            submit_task(pChirpSaver);
+        }
+
+        void profiler::update_long_sweep()
+        {
+            if (pLongSweeper->completed())
+            {
+                LongSweeper::op_t op = pLongSweeper->op();
+                plug::IPort *status =
+                    (op == LongSweeper::OP_EXPORT) ? pLongChirpStatus :
+                    (op == LongSweeper::OP_MEASURE) ? pLongMeasureStatus :
+                    pLongResponseStatus;
+                status->set_value(pLongSweeper->code());
+                pLongSweeper->reset();
+            }
+
+            // The long sweep does not use the chirp processor, so it runs independently from measurements.
+            // The task is reserved for the deconvolution of the realtime long sweep while it is captured
+            if ((!pLongSweeper->idle()) || (bLongCapture))
+                return;
+
+            if (pLongChirpCmd->value() >= 0.5f)
+            {
+                plug::path_t *path = pLongChirpFile->buffer<plug::path_t>();
+                status_t res    = STATUS_BAD_STATE;
+                if ((path != NULL) && (path->path()[0] != '\0'))
+                    res             = pLongSweeper->configure(LongSweeper::OP_EXPORT, path->path(), nSampleRate,
+                                                             pLongDuration->value(), fLtAmplitude);
+                if (res == STATUS_OK)
+                {
+                    pLongChirpStatus->set_value(STATUS_LOADING);
+                    submit_task(pLongSweeper);
+                }
+                else
+                    pLongChirpStatus->set_value(res);
+                return;
+            }
+
+            plug::path_t *path = pLongResponseFile->buffer<plug::path_t>();
+            if ((path == NULL) || (!path->pending()))
+                return;
+
+            path->accept();
+            const char *fname = path->path();
+            if ((fname != NULL) && (fname[0] != '\0'))
+            {
+                status_t res    = pLongSweeper->configure(LongSweeper::OP_DECONVOLVE, fname, nSampleRate,
+                                                         pLongDuration->value(), fLtAmplitude);
+                if (res == STATUS_OK)
+                {
+                    pLongResponseStatus->set_value(STATUS_LOADING);
+                    submit_task(pLongSweeper);
+                }
+                else
+                    pLongResponseStatus->set_value(res);
+            }
+            path->commit();
+        }
+
+        void profiler::start_long_measurement()
+        {
+            // The response is spilled to the file next to the saved result by the capture archiver,
+            // the sweep is played by the audio thread and does not use the chirp processor
+            if ((!pLongSweeper->idle()) || (bCaptureArchiving) || (!pCaptureArchiver->started()) ||
+                (!pCaptureArchiver->idle()) || (sCaptureRing.is_empty()) || (!pSaver->is_file_set()))
+            {
+                pLongMeasureStatus->set_value(STATUS_BAD_STATE);
+                return;
+            }
+
+            // The task deconvolves the response with the same sweep, the file name is known when the capture is closed
+            const float duration = pLongDuration->value();
+            status_t res    = sLongSweep.init(nSampleRate, SYNC_CHIRP_START_FREQ, SYNC_CHIRP_MAX_FREQ, duration, fLtAmplitude);
+            if (res == STATUS_OK)
+                res             = pLongSweeper->configure(LongSweeper::OP_MEASURE, "", nSampleRate, duration, fLtAmplitude);
+            if (res != STATUS_OK)
+            {
+                pLongMeasureStatus->set_value(res);
+                return;
+            }
+
+            system::time_t time;
+            system::get_time(&time);
+
+            // The ring is not accessed by the idle drain thread
+            sCaptureRing.clear();
+            if (!pCaptureArchiver->begin(nSaveIndex, &time, "-long.wav"))
+            {
+                pLongMeasureStatus->set_value(STATUS_BAD_STATE);
+                return;
+            }
+
+            // The response is recorded for the sweep and the longest impulse response computed
+            ++nSaveIndex;
+            nLongOffset     = 0;
+            nLongLength     = sLongSweep.length() + dspu::seconds_to_samples(nSampleRate, LongSweep::TAIL_MAX);
+            nLongOverrun    = 0;
+            bLongCapture    = true;
+            nState          = LONGSWEEP;
+            pLongMeasureStatus->set_value(STATUS_IN_PROCESS);
+        }
+
+        void profiler::update_long_measurement()
+        {
+            if (nTriggers & T_LONG_TRIGGER)
+            {
+                if (nState == LONGSWEEP)
+                {
+                    // The second press cancels the measurement, the capture is closed and not deconvolved
+                    nTriggers      &= ~T_LONG_TRIGGER;
+                    nState          = IDLE;
+                }
+                else if (nState == IDLE)
+                {
+                    // Wait for the ring and the drain thread to be allocated by the Preparer
+                    if (prepare_on_demand())
+                    {
+                        nTriggers      &= ~T_LONG_TRIGGER;
+                        start_long_measurement();
+                    }
+                }
+                else if (nState != PREPARING)
+                {
+                    nTriggers      &= ~T_LONG_TRIGGER;
+                    pLongMeasureStatus->set_value(STATUS_BAD_STATE);
+                }
+            }
+
+            if (!bLongCapture)
+                return;
+
+            nLongOverrun   += sCaptureRing.take_overrun();
+
+            status_t res;
+            if (!pCaptureArchiver->done(&res))
+            {
+                // The drain thread closes the file after the rest of the ring when the sweep is over
+                if (nState != LONGSWEEP)
+                    pCaptureArchiver->finish();
+                return;
+            }
+            bLongCapture    = false;
+
+            // The deconvolution needs every frame of the response, the time origin is lost otherwise
+            if (res == STATUS_OK)
+            {
+                if (nLongOffset < nLongLength)
+                    res             = STATUS_CANCELLED;
+                else if (nLongOverrun > 0)
+                    res             = STATUS_OVERFLOW;
+            }
 
-            pSaveModeSelector           = NULL;
-            pIRFileName                 = NULL;
-            pIRSaveCmd                  = NULL;
-            pIRSaveStatus               = NULL;
-            pIRSavePercent              = NULL;
+            if (res == STATUS_OK)
+            {
+                pLongSweeper->set_file_name(pCaptureArchiver->path());
+                pLongMeasureStatus->set_value(STATUS_LOADING);
+                submit_task(pLongSweeper);
+            }
+            else
+                pLongMeasureStatus->set_value(res);
         }
 
-        profiler::~profiler()
+        bool profiler::lspc_saving()
         {
-            do_destroy();
+            return (pLSPCSaver->submitted()) || (pLSPCSaver->started());
         }
 
-        void profiler::destroy()
+        bool profiler::can_save()
         {
-            plug::Module::destroy();
-            do_destroy();
+            // LSPC file is written from the state of the chirp processor and from the captured responses,
+            // both should match the saved result
+            // The WAV files are written from the copy of the result made by the saver at start,
+            // the chirp processor should hold the front result at this moment
+            bool lspc   = nSaveTargets & (1 << meta::profiler_metadata::SC_SVMOD_NLINEAR);
+            bool busy   = (bResultPending) || (nState == CONVOLVING) ||
+                          ((lspc) && ((nState == PREPROCESSING) || (nState == WAIT) ||
+                                      (nState == RECORDING) || (chirp_exporting())));
+
+            return (vResults[nResultFront].bValid) && (!busy) && (pSaver->is_file_set());
         }
 
-        void profiler::do_destroy()
+        void profiler::start_saving()
         {
-            if (pPreProcessor != NULL)
+            sSaveData.enSaveStatus = STATUS_LOADING;
+            sSaveData.fSavePercent = 0.0f;
+            update_saving_info();
+
+            // Each saving gets new index for the file name template
+            system::time_t time;
+            system::get_time(&time);
+
+            // WAV files and LSPC file are written by independent tasks,
+            // the result is copied only if there are WAV files to write
+            const size_t wav_targets = nSaveTargets & ((1 << WAV_TARGETS) - 1);
+            pSaver->set_result(&vResults[nResultFront]);
+            pSaver->set_targets(nSaveTargets, nSaveMode);
+            pSaver->set_stamp(nSaveIndex, &time);
+            pSaver->set_copy(wav_targets != 0);
+            submit_task(pSaver);
+            if (nSaveTargets & (1 << meta::profiler_metadata::SC_SVMOD_NLINEAR))
             {
-                delete pPreProcessor;
-                pPreProcessor = NULL;
+                pLSPCSaver->set_archive(pArchiveMode->value());
+                submit_task(pLSPCSaver);
             }
 
-            if (pConvolver != NULL)
+            // Each extra sample rate is exported by its own task in parallel, the native
+            // sample rate is already covered by the main saver. Only WAV targets are exported.
+            // The tasks are submitted when the main saver has made the copy of the result.
+            for (size_t i=0; i<EXPORT_RATES; ++i)
             {
-                delete pConvolver;
-                pConvolver = NULL;
+                if ((!(nExportRates & (1 << i))) || (export_rates[i] == nSampleRate) || (wav_targets == 0))
+                    continue;
+
+                Saver *s        = vRateSavers[i];
+                s->set_result(&vResults[nResultFront]);
+                s->set_targets(wav_targets, nSaveMode);
+                s->set_stamp(nSaveIndex, &time);
+                nRatesPending  |= 1 << i;
             }
 
-            if (pPostProcessor != NULL)
+            ++nSaveIndex;
+        }
+
+        bool profiler::rate_saving()
+        {
+            for (size_t i=0; i<EXPORT_RATES; ++i)
             {
-                delete pPostProcessor;
-                pPostProcessor = NULL;
+                Saver *s        = vRateSavers[i];
+                if ((s->submitted()) || (s->started()))
+                    return true;
             }
+            return false;
+        }
 
-            if (pSaver != NULL)
+        void profiler::update_saving()
+        {
+            if (pSaver->idle())
             {
-                delete pSaver;
-                pSaver = NULL;
+                // Start the automatic saving as soon as the previous saving is finished
+                if ((bAutoSavePending) && (can_save()))
+                {
+                    bAutoSavePending    = false;
+                    start_saving();
+                }
+                return;
             }
 
-            if (sResponseData.vResponses != NULL)
+            // Export at other sample rates reads the copy of the result made by the main saver
+            if ((nRatesPending) && (!pSaver->copying()))
             {
-                for (size_t ch = 0; ch < nChannels; ++ch)
+                for (size_t i=0; i<EXPORT_RATES; ++i)
                 {
-                    dspu::Sample *s = sResponseData.vResponses[ch];
-                    if (s != NULL)
-                        s->destroy();
+                    if (nRatesPending & (1 << i))
+                        submit_task(vRateSavers[i]);
                 }
-
-                delete[] sResponseData.vResponses;
-                sResponseData.vResponses = NULL;
+                nRatesPending   = 0;
             }
 
-            free_aligned(sResponseData.pData);
-            sResponseData.pData     = NULL;
-            sResponseData.vOffsets  = NULL;
+            if ((pSaver->completed()) && (!lspc_saving()) && (!rate_saving()) && (!nRatesPending))
+            {
+                status_t res = pSaver->code();
+                if ((res == STATUS_OK) && (pLSPCSaver->completed()))
+                    res         = pLSPCSaver->code();
+                for (size_t i=0; i<EXPORT_RATES; ++i)
+                {
+                    Saver *s        = vRateSavers[i];
+                    if ((res == STATUS_OK) && (s->completed()))
+                        res             = s->code();
+                    s->reset();
+                }
 
-            free_aligned(pData);
-            pData                   = NULL;
-            vTempBuffer             = NULL;
-            vDisplayAbscissa        = NULL;
-            vDisplayOrdinate        = NULL;
+                sSaveData.enSaveStatus  = (res == STATUS_OK) ? STATUS_OK : STATUS_UNKNOWN_ERR;
+                sSaveData.fSavePercent  = (res == STATUS_OK) ? 100.0f : 0.0f;
 
-            if (vChannels != NULL)
+                pSaver->reset();
+                pLSPCSaver->reset();
+            }
+            else
             {
-                for (size_t ch = 0; ch < nChannels; ++ch)
+                // The progress is the average progress of all WAV savers
+                float progress  = pSaver->get_progress();
+                size_t savers   = 1;
+                for (size_t i=0; i<EXPORT_RATES; ++i)
                 {
-                    channel_t *c = &vChannels[ch];
-                    c->sLatencyDetector.destroy();
-                    c->sResponseTaker.destroy();
-                    c->vBuffer = NULL;
+                    Saver *s        = vRateSavers[i];
+                    if (s->idle())
+                        continue;
+                    progress       += s->get_progress();
+                    ++savers;
                 }
-                delete [] vChannels;
-                vChannels = NULL;
+                sSaveData.fSavePercent  = progress / savers;
             }
 
-            sSyncChirpProcessor.destroy();
-            sCalOscillator.destroy();
+            // Report the progress
+            update_saving_info();
         }
 
-        void profiler::update_pre_processing_info()
+        void profiler::start_analysis()
         {
-            pActualDuration->set_value(sSyncChirpProcessor.get_chirp_duration_seconds());
-
-            for (size_t ch = 0; ch < nChannels; ++ch)
-            {
-                vChannels[ch].sResponseTaker.set_op_tail(sSyncChirpProcessor.get_chirp_duration_seconds());
-            }
+            nAnalysisTile   = 0;
         }
 
-        bool profiler::update_post_processing_info()
+        void profiler::update_analysis()
         {
-            ssize_t nIROffset = pPostProcessor->get_ir_offset();
+            const size_t tiles = nChannels * ANALYSIS_TILES;
 
-            for (size_t ch = 0; ch < nChannels; ++ch)
+            // A new measurement replaces the result being analysed, the remaining tiles are cancelled
+            const bool cancel  = (nState == CONVOLVING) || (nState == POSTPROCESSING);
+            if (cancel)
+                nAnalysisTile   = tiles;
+
+            // Deliver the results of each tile to the UI as soon as it is ready
+            if (pAnalyzer->completed())
             {
-                channel_t *c = &vChannels[ch];
+                size_t tile     = pAnalyzer->get_tile();
+                if (cancel)
+                    nAnalysisTile   = tiles;
+                else if (pAnalyzer->successful())
+                {
+                    channel_t *c    = &vChannels[tile / ANALYSIS_TILES];
+                    if ((tile % ANALYSIS_TILES) == 0)
+                        c->bETCPending  = true;
+                    else
+                    {
+                        plug::frame_buffer_t *fb = c->pCSD->buffer<plug::frame_buffer_t>();
+                        if (fb != NULL)
+                        {
+                            for (size_t i=0; i<CSD_TILE_SLICES; ++i)
+                                fb->write_row(&vCSDRows[i * meta::profiler_metadata::CSD_MESH_SIZE]);
+                        }
+                    }
+
+                    nAnalysisTile   = tile + 1;
+                }
+                else
+                    nAnalysisTile   = tiles;
 
-                c->pRTScreen->set_value(c->sPostProc.fReverbTime);
-                c->pRScreen->set_value(c->sPostProc.fCorrCoeff);
-                c->pILScreen->set_value(c->sPostProc.fIntgLimit);
-                c->pRTAccuracyLed->set_value((c->sPostProc.bRTAccuray) ? 1.0f : 0.0f);
+                pAnalyzer->reset();
+            }
+            else if ((pAnalyzer->idle()) && (nAnalysisTile < tiles) && (nState == IDLE) && (!chirp_exporting()))
+            {
+                // Tiles are submitted only in IDLE state to not to interfere with measurements,
+                // the chirp export re-configures the chirp processor and may run concurrently
+                pAnalyzer->set_tile(nAnalysisTile);
+                submit_task(pAnalyzer);
             }
 
-            // Do the plots
+            // Commit the Energy Time Curves as soon as the UI consumes the previous meshes
             for (size_t ch = 0; ch < nChannels; ++ch)
             {
                 channel_t *c = &vChannels[ch];
-                size_t irQuery = (nIROffset > 0) ? c->sPostProc.nReverbTime : c->sPostProc.nReverbTime + size_t(-nIROffset);
+                if (!c->bETCPending)
+                    continue;
 
-                sSyncChirpProcessor.get_convolution_result_plottable_samples(ch, vDisplayOrdinate, nIROffset, irQuery , meta::profiler_metadata::RESULT_MESH_SIZE, true);
-
-                plug::mesh_t *mesh = c->pResultMesh->buffer<plug::mesh_t>();
+                plug::mesh_t *mesh = c->pETCMesh->buffer<plug::mesh_t>();
                 if (mesh != NULL)
                 {
                     if (!mesh->isEmpty())
-                        return false;
+                        continue;
 
-                    dsp::copy(mesh->pvData[0], vDisplayAbscissa, meta::profiler_metadata::RESULT_MESH_SIZE);
-                    dsp::copy(mesh->pvData[1], vDisplayOrdinate, meta::profiler_metadata::RESULT_MESH_SIZE);
-                    mesh->data(2, meta::profiler_metadata::RESULT_MESH_SIZE);
+                    float *x = mesh->pvData[0];
+                    for (size_t n = 0; n < meta::profiler_metadata::ETC_MESH_SIZE; ++n)
+                        x[n] = float(2 * n) / meta::profiler_metadata::ETC_MESH_SIZE;
+                    dsp::copy(mesh->pvData[1], c->vETC, meta::profiler_metadata::ETC_MESH_SIZE);
+                    mesh->data(2, meta::profiler_metadata::ETC_MESH_SIZE);
                 }
-            }
-
-            if (pWrapper != NULL)
-                pWrapper->query_display_draw();
 
-            return true;
-        }
-
-        void profiler::update_saving_info()
-        {
-            pIRSaveStatus->set_value(sSaveData.enSaveStatus);
-            pIRSavePercent->set_value(sSaveData.fSavePercent);
+                c->bETCPending = false;
+            }
         }
 
         dspu::scp_rtcalc_t profiler::get_rt_algorithm(size_t algorithm)
@@ -485,6 +2384,24 @@ namespace lsp
             }
         }
 
+        status_t profiler::store_result(dspu::Sample *dst, const dspu::Sample *src, size_t first, size_t count)
+        {
+            // Sample::copy() allocates new storage for each copy, so both the old and the new
+            // buffers are held at once. The slot keeps its storage while the window fits into it.
+            const size_t channels   = src->channels();
+            const size_t length     = lsp_min(count, src->length() - lsp_min(first, src->length()));
+            if ((dst->channels() == channels) && (dst->max_length() >= length))
+                dst->set_length(length);
+            else if (!dst->init(channels, length, length))
+                return STATUS_NO_MEM;
+
+            for (size_t ch = 0; ch < channels; ++ch)
+                dsp::copy(dst->channel(ch), &src->channel(ch)[first], length);
+            dst->set_sample_rate(src->sample_rate());
+
+            return STATUS_OK;
+        }
+
         void profiler::init(plug::IWrapper *wrapper, plug::IPort **ports)
         {
             plug::Module::init(wrapper, ports);
@@ -492,8 +2409,14 @@ namespace lsp
             pExecutor = wrapper->executor();
             lsp_trace("Executor = %p", pExecutor);
 
-            // 1X Global Temporary Buffer + 2X buffer to plot data + 1X temporary DSP buffer per channel
-            size_t samples = TMP_BUF_SIZE + 2 * meta::profiler_metadata::RESULT_MESH_SIZE + nChannels * TMP_BUF_SIZE;
+            // 1X Global Temporary Buffer + 1X buffer to plot abscissa + 1X buffer for CSD tile rows +
+            // 1X temporary DSP buffer, snapshot plots and ETC buffer per channel
+            size_t samples = TMP_BUF_SIZE + meta::profiler_metadata::RESULT_MESH_SIZE +
+                CSD_TILE_SLICES * meta::profiler_metadata::CSD_MESH_SIZE +
+                nChannels * (
+                    TMP_BUF_SIZE +
+                    2 * TripleBuffer::SLOTS * meta::profiler_metadata::RESULT_MESH_SIZE +
+                    meta::profiler_metadata::ETC_MESH_SIZE);
 
             float *ptr = alloc_aligned<float>(pData, samples);
             if (ptr == NULL)
@@ -504,8 +2427,8 @@ namespace lsp
             ptr                     += TMP_BUF_SIZE;
             vDisplayAbscissa        = ptr;
             ptr                    += meta::profiler_metadata::RESULT_MESH_SIZE;
-            vDisplayOrdinate        = ptr;
-            ptr                    += meta::profiler_metadata::RESULT_MESH_SIZE;
+            vCSDRows                = ptr;
+            ptr                    += CSD_TILE_SLICES * meta::profiler_metadata::CSD_MESH_SIZE;
 
             // vAbscissa never changes, so it can be filled here
             for (size_t n = 0; n < meta::profiler_metadata::RESULT_MESH_SIZE; ++n)
@@ -522,17 +2445,9 @@ namespace lsp
             {
                 channel_t *c = &vChannels[ch];
 
-                c->sLatencyDetector.init();
-                c->sLatencyDetector.set_delay_ratio(0.5f);
-                c->sLatencyDetector.set_duration(0.050f);
-                c->sLatencyDetector.set_op_fading(0.030f);
-                c->sLatencyDetector.set_op_pause(0.025f);
-
-                c->sResponseTaker.init();
-                c->sResponseTaker.set_op_fading(0.030f);
-                c->sResponseTaker.set_op_pause(0.025f);
-
+                // Latency detector and response taker are initialized by the Preparer task
                 c->nLatency         = 0;
+                c->nTakerLatency    = 0;
                 c->bLatencyMeasured = false;
                 c->bLCycleComplete  = false;
                 c->bRCycleComplete  = false;
@@ -546,6 +2461,28 @@ namespace lsp
                 vChannels[ch].vBuffer   = ptr;
                 ptr                    += TMP_BUF_SIZE;
 
+                for (size_t i=0; i<TripleBuffer::SLOTS; ++i)
+                {
+                    snapshot_t *s           = &c->vSnapshots[i];
+                    s->sPostProc            = c->sPostProc;
+                    s->vPlot                = ptr;
+                    ptr                    += meta::profiler_metadata::RESULT_MESH_SIZE;
+                    dsp::fill_zero(s->vPlot, meta::profiler_metadata::RESULT_MESH_SIZE);
+
+                    s                       = &c->vDisplay[i];
+                    s->sPostProc            = c->sPostProc;
+                    s->vPlot                = ptr;
+                    ptr                    += meta::profiler_metadata::RESULT_MESH_SIZE;
+                    dsp::fill_zero(s->vPlot, meta::profiler_metadata::RESULT_MESH_SIZE);
+                }
+                c->bPlotPending         = false;
+
+                c->fCSDReference        = 0.0f;
+                c->vETC                 = ptr;
+                ptr                    += meta::profiler_metadata::ETC_MESH_SIZE;
+                c->bETCPending          = false;
+                dsp::fill(c->vETC, meta::profiler_metadata::ETC_FLOOR, meta::profiler_metadata::ETC_MESH_SIZE);
+
                 c->vIn  = NULL;
                 c->vOut = NULL;
 
@@ -559,6 +2496,8 @@ namespace lsp
                 c->pILScreen        = NULL;
                 c->pRScreen         = NULL;
                 c->pResultMesh      = NULL;
+                c->pETCMesh         = NULL;
+                c->pCSD             = NULL;
             }
 
             lsp_assert(ptr <= &save[samples]);
@@ -578,28 +2517,31 @@ namespace lsp
             sRDptr                 += nChannels;
             lsp_assert(sRDptr <= &sRDsave[nChannels]);
 
-            if (!sCalOscillator.init())
-                return;
-            sCalOscillator.set_function(dspu::FG_SINE);
-            sCalOscillator.set_dc_offset(0.0f);
-            sCalOscillator.set_dc_reference(dspu::DC_ZERO);
-            sCalOscillator.set_phase(0.0f);
-
-            if (!sSyncChirpProcessor.init())
-                return;
-            sSyncChirpProcessor.set_chirp_synthesis_method(dspu::SCP_SYNTH_BANDLIMITED);
-            sSyncChirpProcessor.set_chirp_initial_frequency(SYNC_CHIRP_START_FREQ);
-            sSyncChirpProcessor.set_chirp_final_frequency(SYNC_CHIRP_MAX_FREQ);
+            // Oscillator and chirp processor allocate their buffers in the Preparer task on the first
+            // calibration or measurement, the instances that are never used do not allocate them at all
             sSyncChirpProcessor.set_chirp_amplitude(meta::profiler_metadata::AMPLITUDE_DFL);
-            sSyncChirpProcessor.set_fader_fading_method(dspu::SCP_FADE_RAISED_COSINES);
-            sSyncChirpProcessor.set_fader_fadein(0.500f);
-            sSyncChirpProcessor.set_fader_fadeout(0.020f);
-            sSyncChirpProcessor.set_oversampler_mode(dspu::OM_LANCZOS_8X2);
 
+            pPoolStarter            = new PoolStarter(this);
+            pTuner                  = new Tuner();
+            pPreparer               = new Preparer(this);
             pPreProcessor           = new PreProcessor(this);
             pConvolver              = new Convolver(this);
             pPostProcessor          = new PostProcessor(this);
             pSaver                  = new Saver(this);
+            for (size_t i=0; i<EXPORT_RATES; ++i)
+            {
+                vRateSavers[i]          = new Saver(this);
+                vRateSavers[i]->set_rate(export_rates[i]);
+            }
+            pLSPCSaver              = new LSPCSaver(this);
+            pChirpSaver             = new ChirpSaver(this);
+            pLongSweeper            = new LongSweeper();
+            pCaptureArchiver        = new CaptureArchiver(this);
+            pAnalyzer               = new Analyzer(this);
+            nAnalysisTile           = nChannels * ANALYSIS_TILES; // Nothing to analyse yet
+
+            if (sDecayAnalyzer.init(ANALYSIS_FFT_RANK) != STATUS_OK)
+                return;
 
             // Bind ports
             size_t port_id          = 0;
@@ -622,6 +2564,7 @@ namespace lsp
             pBypass             = ports[port_id++];
 
             pStateLEDs          = ports[port_id++];
+            pWorkerPool         = ports[port_id++];
 
             pCalFrequency       = ports[port_id++];
             pCalAmplitude       = ports[port_id++];
@@ -636,17 +2579,47 @@ namespace lsp
 
             pDuration           = ports[port_id++];
             pActualDuration     = ports[port_id++];
+            pChirpQuality       = ports[port_id++];
+            pPreprocTime        = ports[port_id++];
             pLinTrigger         = ports[port_id++];
 
             pIROffset           = ports[port_id++];
+            pIRAutoOffset       = ports[port_id++];
+            pIROffsetMeter      = ports[port_id++];
             pRTAlgoSelector     = ports[port_id++];
             pPostTrigger        = ports[port_id++];
 
             pSaveModeSelector   = ports[port_id++];
+            for (size_t i=0; i<SAVE_TARGETS; ++i)
+                vSaveTargets[i]     = ports[port_id++];
             pIRFileName         = ports[port_id++];
             pIRSaveCmd          = ports[port_id++];
             pIRSaveStatus       = ports[port_id++];
             pIRSavePercent      = ports[port_id++];
+            pAutoSave           = ports[port_id++];
+            for (size_t i=0; i<EXPORT_RATES; ++i)
+                vExportRates[i]     = ports[port_id++];
+            pIRLoadFile         = ports[port_id++];
+            pIRLoadStatus       = ports[port_id++];
+            pArchiveMode        = ports[port_id++];
+            pCaptureSwitch      = ports[port_id++];
+            pCaptureStatus      = ports[port_id++];
+
+            // Offline measurement
+            lsp_trace("Binding offline measurement ports");
+            pChirpFile          = ports[port_id++];
+            pChirpCmd           = ports[port_id++];
+            pChirpStatus        = ports[port_id++];
+            pResponseFile       = ports[port_id++];
+            pResponseStatus     = ports[port_id++];
+            pLongDuration       = ports[port_id++];
+            pLongChirpFile      = ports[port_id++];
+            pLongChirpCmd       = ports[port_id++];
+            pLongChirpStatus    = ports[port_id++];
+            pLongResponseFile   = ports[port_id++];
+            pLongResponseStatus = ports[port_id++];
+            pLongMeasureCmd     = ports[port_id++];
+            pLongMeasureStatus  = ports[port_id++];
 
             // Data Visualisation
             lsp_trace("Binding data visualisation ports");
@@ -672,6 +2645,12 @@ namespace lsp
 
                 TRACE_PORT(ports[port_id]);
                 vChannels[ch].pResultMesh       = ports[port_id++];
+
+                TRACE_PORT(ports[port_id]);
+                vChannels[ch].pETCMesh          = ports[port_id++];
+
+                TRACE_PORT(ports[port_id]);
+                vChannels[ch].pCSD              = ports[port_id++];
             }
         }
 
@@ -680,14 +2659,29 @@ namespace lsp
             nSampleRate = sr;
 
             for (size_t ch = 0; ch < nChannels; ++ch)
-            {
                 vChannels[ch].sBypass.init(sr);
+
+            // The objects are being initialized by the Preparer, it is submitted again
+            // on completion if the sample rate has changed meanwhile
+            if ((pPreparer != NULL) && (!pPreparer->idle()))
+                return;
+
+            for (size_t ch = 0; ch < nChannels; ++ch)
+            {
                 vChannels[ch].sLatencyDetector.set_sample_rate(sr);
                 vChannels[ch].sResponseTaker.set_sample_rate(sr);
             }
 
             sCalOscillator.set_sample_rate(sr);
             sSyncChirpProcessor.set_sample_rate(sr);
+
+            // The long sweep is computed for the previous sample rate, the capture is cancelled
+            if (nState == LONGSWEEP)
+                nState      = IDLE;
+
+            // The ring is allocated here, so the audio thread never allocates memory for archiving
+            if ((bPrepared) && (!bCaptureArchiving) && (!bLongCapture))
+                sCaptureRing.init(nChannels, dspu::seconds_to_samples(sr, CAPTURE_RING_TIME));
         }
 
         void profiler::process_buffer(size_t to_do)
@@ -701,6 +2695,38 @@ namespace lsp
                 }
                 break;
 
+                case PREPARING:
+                {
+                    // Submit the task the first time we get here, the triggers that caused the preparation
+                    // are kept pending and are committed again when the task completes. Tasks may run
+                    // concurrently on the worker pool, the analysis tile should not see the objects re-initialized
+                    if (pPreparer->idle())
+                    {
+                        if (pAnalyzer->idle())
+                            submit_task(pPreparer);
+                    }
+                    else if ((pPreparer->completed()) && (pPreparer->sample_rate() != nSampleRate))
+                    {
+                        // The sample rate has changed while preparing, prepare the objects again
+                        pPreparer->reset();
+                    }
+                    else if (pPreparer->completed())
+                    {
+                        bPrepared   = pPreparer->successful();
+                        nState      = IDLE;
+                        if (bPrepared)
+                            nTriggers  |= T_CHANGE;
+                        else
+                            nTriggers  &= ~(T_LAT_TRIGGER | T_LIN_TRIGGER | T_POSTPROCESS);
+
+                        pPreparer->reset();
+                    }
+
+                    for (size_t ch = 0; ch < nChannels; ++ch)
+                        dsp::fill_zero(vChannels[ch].vBuffer, to_do);
+                }
+                break;
+
                 case CALIBRATION:
                 {
                     // Create one calibrator output sequence all, and copy it over the other channels
@@ -748,6 +2774,7 @@ namespace lsp
 
                             c->pLatencyScreen->set_value(c->sLatencyDetector.get_latency_seconds() * 1000.0f); // * 1000.0f to show ms instead of s
                             c->sResponseTaker.set_latency_samples(c->nLatency);
+                            c->nTakerLatency    = c->nLatency;
                             c->sLatencyDetector.reset_capture();
                         }
                         else if (c->sLatencyDetector.cycle_complete())
@@ -779,14 +2806,23 @@ namespace lsp
                 case PREPROCESSING:
                 {
                     // Check task state. If needed (first time we get here after state transition) submit the
-                    // task.
+                    // task. The chirp should not be changed while LSPC file is being written or analysed.
                     if (pPreProcessor->idle())
-                        pExecutor->submit(pPreProcessor);
+                    {
+                        if ((!lspc_saving()) && (!chirp_exporting()) && (pAnalyzer->idle()))
+                        {
+                            if (bChirpPending)
+                                commit_chirp();
+                            restore_chirp();
+                            submit_task(pPreProcessor);
+                        }
+                    }
                     else if (pPreProcessor->completed()) // Advance machine status only if when (and if) the pre processing task is completed
                     {
                         nState = (pPreProcessor->successful()) ? WAIT : IDLE;
                         if (nState == WAIT)
                             update_pre_processing_info();
+                        pPreprocTime->set_value(pPreProcessor->time());
 
                         pPreProcessor->reset();
                     }
@@ -810,6 +2846,7 @@ namespace lsp
                             vChannels[ch].sResponseTaker.start_capture();
                             vChannels[ch].bRCycleComplete = false;
                         }
+                        start_capture_archive();
                     }
 
                     for (size_t ch = 0; ch < nChannels; ++ch)
@@ -843,6 +2880,15 @@ namespace lsp
                         bAllComplete = bAllComplete && c->bRCycleComplete;
                     }
 
+                    // Pass the raw input to the archiving task, the frames that do not fit are dropped
+                    if (bCaptureArchiving)
+                    {
+                        const float *vin[CHANNELS_MAX];
+                        for (size_t ch = 0; ch < nChannels; ++ch)
+                            vin[ch]     = vChannels[ch].vIn;
+                        sCaptureRing.write(vin, to_do);
+                    }
+
                     if (bAllComplete)
                         nState = CONVOLVING;
                 }
@@ -851,12 +2897,45 @@ namespace lsp
                 case CONVOLVING:
                 {
                     if (pConvolver->idle())
-                        pExecutor->submit(pConvolver);
+                    {
+                        // LSPC file is written from the state of the chirp processor, wait for it
+                        // The analysis tile that may still run reads the convolution result, wait for it too,
+                        // as well as for the saver that copies the result
+                        if ((!lspc_saving()) && (pAnalyzer->idle()) && (!pSaver->copying()))
+                        {
+                            // Write to the slot that is not being saved
+                            nResultBack = nResultFront ^ 1;
+                            if ((!pSaver->idle()) && (pSaver->get_result() == &vResults[nResultBack]))
+                                nResultBack = nResultFront;
+                            vResults[nResultBack].bValid = false;
+
+                            submit_task(pConvolver);
+                        }
+                    }
                     else if (pConvolver->completed())
                     {
-                        bIRMeasured = true;
+                        bool success    = pConvolver->successful();
+                        Convolver::source_t source = pConvolver->source();
+                        if (source != Convolver::SRC_CAPTURE)
+                        {
+                            // The chirp processor holds the state of the loaded measurement now
+                            if (source == Convolver::SRC_LSPC)
+                                bChirpLoaded    = true;
+
+                            plug::IPort *file   = (source == Convolver::SRC_LSPC) ? pIRLoadFile : pResponseFile;
+                            plug::IPort *status = (source == Convolver::SRC_LSPC) ? pIRLoadStatus : pResponseStatus;
+                            status->set_value(pConvolver->code());
+                            pConvolver->set_source(Convolver::SRC_CAPTURE, NULL);
+
+                            plug::path_t *path = file->buffer<plug::path_t>();
+                            if (path != NULL)
+                                path->commit();
+                        }
+
+                        bIRMeasured     = success;
+                        bResultPending  = success;
                         pConvolver->reset();
-                        nState = POSTPROCESSING;
+                        nState          = (success) ? POSTPROCESSING : IDLE;
                     }
 
                     for (size_t ch = 0; ch < nChannels; ++ch)
@@ -868,21 +2947,29 @@ namespace lsp
                 {
                     if (pPostProcessor->idle())
                     {
-                        ssize_t nIROffset = dspu::millis_to_samples(nSampleRate, pIROffset->value());
-                        pPostProcessor->set_ir_offset(nIROffset);
-                        pSaver->set_ir_offset(nIROffset); // We set it here also for the saver, so that it matches the postprocessing value.
-                        pPostProcessor->set_rt_algo(get_rt_algorithm(pRTAlgoSelector->value()));
-                        pExecutor->submit(pPostProcessor);
+                        // The analysis tile and the LSPC file writer read the post-processing state,
+                        // submit only when both are finished
+                        if ((pAnalyzer->idle()) && (!lspc_saving()) && (!pSaver->copying()))
+                        {
+                            ssize_t nIROffset = dspu::millis_to_samples(nSampleRate, pIROffset->value());
+                            pPostProcessor->set_ir_offset(nIROffset);
+                            pPostProcessor->set_auto_offset(pIRAutoOffset->value() >= 0.5f);
+                            pPostProcessor->set_rt_algo(get_rt_algorithm(pRTAlgoSelector->value()));
+                            submit_task(pPostProcessor);
+                        }
                     }
                     else if (pPostProcessor->completed())
                     {
-                        // We should loop until the output mesh is committed to UI
-                        if (update_post_processing_info())
-                        {
-                            bIRMeasured = true;
-                            nState      = IDLE;
-                            pPostProcessor->reset();
-                        }
+                        // The results are published by the task, the plots are committed by update_post_processing_info()
+                        // The offset may be detected by the task, the saved result should match the post-processing value
+                        ssize_t nIROffset = pPostProcessor->get_ir_offset();
+                        pIROffsetMeter->set_value(dspu::samples_to_millis(nSampleRate, nIROffset));
+                        commit_result();
+
+                        bIRMeasured = true;
+                        nState      = IDLE;
+                        pPostProcessor->reset();
+                        start_analysis();
                     }
 
                     for (size_t ch = 0; ch < nChannels; ++ch)
@@ -892,23 +2979,29 @@ namespace lsp
 
                 case SAVING:
                 {
-                    if (pSaver->idle())
-                    {
-                        sSaveData.enSaveStatus = STATUS_LOADING;
-                        sSaveData.fSavePercent = 0.0f;
-                        update_saving_info();
+                    // Saving is performed in background, the state is never set
+                    for (size_t ch = 0; ch < nChannels; ++ch)
+                        dsp::fill_zero(vChannels[ch].vBuffer, to_do);
+                }
+                break;
 
-                        pExecutor->submit(pSaver);
-                    }
-                    else if (pSaver->completed())
-                    {
-                        update_saving_info();
-                        nState      = IDLE;
-                        pSaver->reset();
-                    }
+                case LONGSWEEP:
+                {
+                    // The sweep is computed block by block, it is never kept in memory
+                    sLongSweep.chirp(vTempBuffer, nLongOffset, to_do);
+                    for (size_t ch = 0; ch < nChannels; ++ch)
+                        dsp::copy(vChannels[ch].vBuffer, vTempBuffer, to_do);
 
+                    // The response is passed to the drain thread which spills it to disk
+                    const size_t count  = lsp_min(wsize_t(to_do), nLongLength - nLongOffset);
+                    const float *vin[CHANNELS_MAX];
                     for (size_t ch = 0; ch < nChannels; ++ch)
-                        dsp::fill_zero(vChannels[ch].vBuffer, to_do);
+                        vin[ch]     = vChannels[ch].vIn;
+                    sCaptureRing.write(vin, count);
+
+                    nLongOffset    += count;
+                    if (nLongOffset >= nLongLength)
+                        nState          = IDLE;
                 }
                 break;
             }
@@ -936,17 +3029,27 @@ namespace lsp
                 path->accept();
                 lsp_trace("set file name to %s", path->path());
                 pSaver->set_file_name(path->path());
+                for (size_t i=0; i<EXPORT_RATES; ++i)
+                    vRateSavers[i]->set_file_name(path->path());
+                nSaveIndex      = 1;
 
                 // Commit
                 path->commit();
             }
 
-            // Set state to SAVING if all conditions are met
-            if (pIRSaveCmd->value() > 0.5f)
+            // Load previously saved measurement or recorded response when the plugin is idle
+            start_loading(pIRLoadFile, pIRLoadStatus, Convolver::SRC_LSPC);
+            start_loading(pResponseFile, pResponseStatus, Convolver::SRC_RESPONSE);
+            update_chirp_export();
+            update_long_sweep();
+            update_long_measurement();
+
+            // Start saving in background if all conditions are met
+            if ((pIRSaveCmd->value() > 0.5f) && (pSaver->idle()))
             {
-                if ((nState == IDLE) && (bIRMeasured) && (pSaver->is_file_set()))
-                    nState = SAVING;
-                else if (nState != SAVING)
+                if (can_save())
+                    start_saving();
+                else
                 {
                     sSaveData.enSaveStatus  = STATUS_BAD_STATE;
                     sSaveData.fSavePercent  = 0.0f;
@@ -976,9 +3079,114 @@ namespace lsp
                 samples    -= to_do;
             }
 
+            // Publish post-processing results
+            update_post_processing_info();
+            update_analysis();
+
             // Write always
     //        lsp_trace("state = %d", nState);
-            pStateLEDs->set_value(nState);
+            update_saving();
+            if ((bChirpPending) && (!lspc_saving()))
+                commit_chirp();
+            update_capture_archive();
+            update_worker_pool();
+            update_tuner();
+            pStateLEDs->set_value(
+                (nState == LONGSWEEP) ? RECORDING :
+                ((nState == IDLE) && (!pSaver->idle())) ? SAVING : nState);
+        }
+
+        bool profiler::inline_display(plug::ICanvas *cv, size_t width, size_t height)
+        {
+            // Check proportions
+            if (height > (M_RGOLD_RATIO * width))
+                height  = M_RGOLD_RATIO * width;
+
+            // Init canvas
+            if (!cv->init(width, height))
+                return false;
+            width   = cv->width();
+            height  = cv->height();
+
+            // Clear background
+            bool bypassing = vChannels[0].sBypass.bypassing();
+            cv->set_color_rgb((bypassing) ? CV_DISABLED : CV_BACKGROUND);
+            cv->paint();
+
+            // The snapshots of the display are published by the audio thread and consumed only here
+            const bool fresh        = sDisplay.fetch();
+            const size_t points     = meta::profiler_metadata::RESULT_MESH_SIZE;
+            const size_t slot       = sDisplay.front();
+            const float lane        = float(height) / float(nChannels);
+
+            // Rasterise the plots only when the result or the size of the display changes,
+            // all other calls just re-draw the cached geometry
+            if ((pIDisplay == NULL) ||
+                (nIDisplayWidth != width) ||
+                (nIDisplayHeight != height) ||
+                (fresh))
+            {
+                // Allocate buffer: x, y for each channel
+                pIDisplay           = core::IDBuffer::reuse(pIDisplay, nChannels + 1, points);
+                core::IDBuffer *b   = pIDisplay;
+                if (b == NULL)
+                    return false;
+
+                dsp::mul_k3(b->v[0], vDisplayAbscissa, 0.5f * width, points);
+                for (size_t ch = 0; ch < nChannels; ++ch)
+                {
+                    float *y = b->v[ch + 1];
+                    dsp::mul_k3(y, vChannels[ch].vDisplay[slot].vPlot, -0.45f * lane, points);
+                    dsp::add_k2(y, lane * (ch + 0.5f), points);
+                }
+
+                nIDisplayWidth      = width;
+                nIDisplayHeight     = height;
+            }
+
+            core::IDBuffer *b   = pIDisplay;
+
+            // Draw the time grid
+            cv->set_line_width(1.0f);
+            cv->set_color_rgb((bypassing) ? CV_SILVER : CV_YELLOW, 0.5f);
+            for (size_t i=1; i<4; ++i)
+            {
+                float x = (width * i) >> 2;
+                cv->line(x, 0, x, height);
+            }
+
+            static const uint32_t c_colors[] =
+            {
+                CV_MIDDLE_CHANNEL,
+                CV_LEFT_CHANNEL, CV_RIGHT_CHANNEL
+            };
+            const uint32_t *colors = (nChannels > 1) ? &c_colors[1] : c_colors;
+
+            for (size_t ch = 0; ch < nChannels; ++ch)
+            {
+                const postproc_t *pp    = &vChannels[ch].vDisplay[slot].sPostProc;
+                float yc                = lane * (ch + 0.5f);
+
+                // Zero level, red if the background noise is not optimal for RT calculation
+                cv->set_line_width(1.0f);
+                cv->set_color_rgb((bypassing) ? CV_SILVER : (pp->bRTAccuray) ? CV_WHITE : CV_RED, 0.5f);
+                cv->line(0, yc, width, yc);
+
+                // Coarse IR duration, the plot spans from the IR offset up to the reverberation time
+                if ((pp->fReverbTime > 0.0f) && (pp->fIntgLimit < pp->fReverbTime))
+                {
+                    float x = width * pp->fIntgLimit / pp->fReverbTime;
+                    cv->set_color_rgb((bypassing) ? CV_SILVER : colors[ch], 0.5f);
+                    cv->line(x, yc - 0.5f * lane, x, yc + 0.5f * lane);
+                }
+
+                // The impulse response
+                cv->set_line_width(2.0f);
+                cv->set_color_rgb((bypassing) ? CV_SILVER : colors[ch]);
+                cv->draw_lines(b->v[0], b->v[ch + 1], points);
+            }
+
+            return true;
         }
 
         void profiler::update_settings()
@@ -988,6 +3196,8 @@ namespace lsp
             for (size_t ch = 0; ch < nChannels; ++ch)
                 vChannels[ch].sBypass.set_bypass(bPassValue);
 
+            bWorkerPool             = pWorkerPool->value() >= 0.5f;
+
             // Mark that there is pending state change request
             nTriggers               |= T_CHANGE;
 
@@ -1018,6 +3228,15 @@ namespace lsp
             if (old && (!(nTriggers & T_POSTPROCESS_STATE))) // React on button release
                 nTriggers                  |= T_POSTPROCESS;
 
+            // Realtime long sweep trigger, starts the measurement or cancels the running one
+            old = nTriggers & T_LONG_TRIGGER_STATE;
+            if (pLongMeasureCmd->value() >= 0.5f)
+                nTriggers                  |= T_LONG_TRIGGER_STATE;
+            else
+                nTriggers                  &= ~T_LONG_TRIGGER_STATE;
+            if (old && (!(nTriggers & T_LONG_TRIGGER_STATE))) // React on button release
+                nTriggers                  |= T_LONG_TRIGGER;
+
             // Calibration switch
             if (pCalSwitch->value() >= 0.5f)
                 nTriggers                  |= T_CALIBRATION;
@@ -1042,7 +3261,6 @@ namespace lsp
             pPreProcessor->reset();
             pConvolver->reset();
             pPostProcessor->reset();
-            pSaver->reset();
 
             for (size_t ch = 0; ch < nChannels; ++ch)
                 vChannels[ch].sResponseTaker.reset_capture();
@@ -1086,17 +3304,34 @@ namespace lsp
             sCalOscillator.set_frequency(pCalFrequency->value());
 
             // Change duration setting only if the controller actually changed
-            sSyncChirpProcessor.set_chirp_duration(scDurationSetting);
-            sSyncChirpProcessor.set_chirp_amplitude(fLtAmplitude);
+            commit_chirp();
             pActualDuration->set_value(scDurationSetting);
 
             size_t saveMode = pSaveModeSelector->value();
-            if (saveMode != nSaveMode)
+            size_t saveTargets = 1 << saveMode;
+            for (size_t i=0; i<SAVE_TARGETS; ++i)
             {
-                nSaveMode   = saveMode;
-                reset_saver = true;
+                if (vSaveTargets[i]->value() >= 0.5f)
+                    saveTargets    |= 1 << i;
+            }
+            size_t exportRates = 0;
+            for (size_t i=0; i<EXPORT_RATES; ++i)
+            {
+                if (vExportRates[i]->value() >= 0.5f)
+                    exportRates    |= 1 << i;
+            }
+            if ((saveMode != nSaveMode) || (saveTargets != nSaveTargets) || (exportRates != nExportRates))
+            {
+                nSaveMode       = saveMode;
+                nSaveTargets    = saveTargets;
+                nExportRates    = exportRates;
+                reset_saver     = true;
             }
 
+            // Allocate DSP objects before the first calibration or measurement
+            if ((nTriggers & (T_CALIBRATION | T_LIN_TRIGGER | T_LAT_TRIGGER | T_POSTPROCESS)) && (!prepare_on_demand()))
+                return;
+
             // Update state according to pressed triggers
             if (nTriggers & T_CALIBRATION)
             {
@@ -1179,13 +3414,13 @@ namespace lsp
             // Reset all pending trigger events (mark as processed)
             nTriggers &= ~(T_CHANGE | T_LAT_TRIGGER | T_LIN_TRIGGER | T_POSTPROCESS);
 
-            // Reset saver
-            if (reset_saver)
+            // Reset saver status, the saving in progress reports its own status
+            if ((reset_saver) && (pSaver->idle()))
                 pIRSaveStatus->set_value(STATUS_UNSPECIFIED);
 
-            // Update pending settings for processors
-            if (sSyncChirpProcessor.needs_update())
-                sSyncChirpProcessor.update_settings();
+            // Update pending settings for processors, they are applied after preparation
+            if (!bPrepared)
+                return;
             if (sCalOscillator.needs_update())
                 sCalOscillator.update_settings();
 
@@ -1216,6 +3451,7 @@ namespace lsp
                         v->write_object("sResponseTaker", &c->sResponseTaker);
 
                         v->write("nLatency", c->nLatency);
+                        v->write("nTakerLatency", c->nTakerLatency);
                         v->write("bLatencyMeasured", c->bLatencyMeasured);
                         v->write("bLCycleComplete", c->bLCycleComplete);
                         v->write("bRCycleComplete", c->bRCycleComplete);
@@ -1230,6 +3466,46 @@ namespace lsp
                             v->write("bRTAccuray", pp->bRTAccuray);
                         }
                         v->end_object();
+                        v->write_object("sPyramid", &c->sPyramid);
+                        v->write_object("sFileResponse", &c->sFileResponse);
+                        v->begin_array("vSnapshots", c->vSnapshots, TripleBuffer::SLOTS);
+                        {
+                            for (size_t j=0; j<TripleBuffer::SLOTS; ++j)
+                            {
+                                const snapshot_t *s = &c->vSnapshots[j];
+                                v->begin_object(s, sizeof(snapshot_t));
+                                {
+                                    v->write("fReverbTime", s->sPostProc.fReverbTime);
+                                    v->write("nReverbTime", s->sPostProc.nReverbTime);
+                                    v->write("fCorrCoeff", s->sPostProc.fCorrCoeff);
+                                    v->write("fIntgLimit", s->sPostProc.fIntgLimit);
+                                    v->write("bRTAccuray", s->sPostProc.bRTAccuray);
+                                    v->write("vPlot", s->vPlot);
+                                }
+                                v->end_object();
+                            }
+                        }
+                        v->end_array();
+                        v->begin_array("vDisplay", c->vDisplay, TripleBuffer::SLOTS);
+                        {
+                            for (size_t j=0; j<TripleBuffer::SLOTS; ++j)
+                            {
+                                const snapshot_t *s = &c->vDisplay[j];
+                                v->begin_object(s, sizeof(snapshot_t));
+                                {
+                                    v->write("fReverbTime", s->sPostProc.fReverbTime);
+                                    v->write("fIntgLimit", s->sPostProc.fIntgLimit);
+                                    v->write("bRTAccuray", s->sPostProc.bRTAccuray);
+                                    v->write("vPlot", s->vPlot);
+                                }
+                                v->end_object();
+                            }
+                        }
+                        v->end_array();
+                        v->write("bPlotPending", c->bPlotPending);
+                        v->write("fCSDReference", c->fCSDReference);
+                        v->write("vETC", c->vETC);
+                        v->write("bETCPending", c->bETCPending);
 
                         v->write("vBuffer", c->vBuffer);
                         v->write("vIn", c->vIn);
@@ -1243,6 +3519,8 @@ namespace lsp
                         v->write("pILScreen", c->pILScreen);
                         v->write("pRScreen", c->pRScreen);
                         v->write("pResultMesh", c->pResultMesh);
+                        v->write("pETCMesh", c->pETCMesh);
+                        v->write("pCSD", c->pCSD);
                     }
                     v->end_object();
                 }
@@ -1275,29 +3553,89 @@ namespace lsp
             v->write_object("sSyncChirpProcessor", &sSyncChirpProcessor);
 
             v->write("pExecutor", pExecutor);
+            v->write_object("sWorkerPool", &sWorkerPool);
+            v->write("pPoolStarter", pPoolStarter);
+            v->write("pTuner", pTuner);
+            v->write("bWorkerPool", bWorkerPool);
+            v->write("bPoolStarted", bPoolStarted);
+            v->write("pPreparer", pPreparer);
+            v->write("bPrepared", bPrepared);
             v->write("pPreProcessor", pPreProcessor);
             v->write("pConvolver", pConvolver);
             v->write("pPostProcessor", pPostProcessor);
             v->write("pSaver", pSaver);
+            v->writev("vRateSavers", vRateSavers, EXPORT_RATES);
+            v->write("pLSPCSaver", pLSPCSaver);
+            v->write("pChirpSaver", pChirpSaver);
+            v->write("pLongSweeper", pLongSweeper);
+            v->write("pCaptureArchiver", pCaptureArchiver);
+            v->write_object("sCaptureRing", &sCaptureRing);
+            v->write("bCaptureArchiving", bCaptureArchiving);
+            v->write("nCaptureOverrun", nCaptureOverrun);
+            v->write_object("sLongSweep", &sLongSweep);
+            v->write("nLongOffset", nLongOffset);
+            v->write("nLongLength", nLongLength);
+            v->write("nLongOverrun", nLongOverrun);
+            v->write("bLongCapture", bLongCapture);
+            v->write("pAnalyzer", pAnalyzer);
+
+            v->write_object("sDecayAnalyzer", &sDecayAnalyzer);
+            v->write("nAnalysisTile", nAnalysisTile);
+            v->write("vCSDRows", vCSDRows);
 
             v->write("nSampleRate", nSampleRate);
+            v->write("nIROrigin", nIROrigin);
             v->write("fLtAmplitude", fLtAmplitude);
             v->write("nWaitCounter", nWaitCounter);
             v->write("bDoLatencyOnly", bDoLatencyOnly);
 
             v->write("fScpDurationPrevious", fScpDurationPrevious);
+            v->write("nChirpQuality", nChirpQuality);
             v->write("bIRMeasured", bIRMeasured);
+            v->begin_array("vResults", vResults, RESULT_SLOTS);
+            {
+                for (size_t i=0; i<RESULT_SLOTS; ++i)
+                {
+                    const result_t *r = &vResults[i];
+                    v->begin_object(r, sizeof(result_t));
+                    {
+                        v->write("nOrigin", r->nOrigin);
+                        v->write("nOffset", r->nOffset);
+                        v->write("fReverbTime", r->fReverbTime);
+                        v->write("fIntgLimit", r->fIntgLimit);
+                        v->write("bValid", r->bValid);
+                    }
+                    v->end_object();
+                }
+            }
+            v->end_array();
+            v->write("nResultFront", nResultFront);
+            v->write("nResultBack", nResultBack);
+            v->write("bResultPending", bResultPending);
+            v->write("nSaveIndex", nSaveIndex);
+            v->write("nRatesPending", nRatesPending);
+            v->write_object("sSavedIR", &sSavedIR);
+            v->write("nSavedFirst", nSavedFirst);
+            v->write("nSavedLength", nSavedLength);
+            v->write("bAutoSavePending", bAutoSavePending);
+            v->write("bChirpLoaded", bChirpLoaded);
+            v->write("bChirpPending", bChirpPending);
             v->write("nSaveMode", nSaveMode);
+            v->write("nSaveTargets", nSaveTargets);
+            v->write("nExportRates", nExportRates);
 
             v->write("nTriggers", nTriggers);
 
             v->write("vTempBuffer", vTempBuffer);
             v->write("vDisplayAbscissa", vDisplayAbscissa);
-            v->write("vDisplayOrdinate", vDisplayOrdinate);
+            v->write("pIDisplay", pIDisplay);
+            v->write("nIDisplayWidth", nIDisplayWidth);
+            v->write("nIDisplayHeight", nIDisplayHeight);
             v->write("pData", pData);
 
             v->write("pBypass", pBypass);
             v->write("pStateLEDs", pStateLEDs);
+            v->write("pWorkerPool", pWorkerPool);
 
             v->write("pCalFrequency", pCalFrequency);
             v->write("pCalAmplitude", pCalAmplitude);
@@ -1312,17 +3650,42 @@ namespace lsp
 
             v->write("pDuration", pDuration);
             v->write("pActualDuration", pActualDuration);
+            v->write("pChirpQuality", pChirpQuality);
+            v->write("pPreprocTime", pPreprocTime);
             v->write("pLinTrigger", pLinTrigger);
 
             v->write("pIROffset", pIROffset);
+            v->write("pIRAutoOffset", pIRAutoOffset);
+            v->write("pIROffsetMeter", pIROffsetMeter);
             v->write("pRTAlgoSelector", pRTAlgoSelector);
             v->write("pPostTrigger", pPostTrigger);
 
             v->write("pSaveModeSelector", pSaveModeSelector);
+            v->writev("vSaveTargets", vSaveTargets, SAVE_TARGETS);
+            v->writev("vExportRates", vExportRates, EXPORT_RATES);
             v->write("pIRFileName", pIRFileName);
             v->write("pIRSaveCmd", pIRSaveCmd);
             v->write("pIRSaveStatus", pIRSaveStatus);
             v->write("pIRSavePercent", pIRSavePercent);
+            v->write("pAutoSave", pAutoSave);
+            v->write("pIRLoadFile", pIRLoadFile);
+            v->write("pIRLoadStatus", pIRLoadStatus);
+            v->write("pArchiveMode", pArchiveMode);
+            v->write("pChirpFile", pChirpFile);
+            v->write("pChirpCmd", pChirpCmd);
+            v->write("pChirpStatus", pChirpStatus);
+            v->write("pResponseFile", pResponseFile);
+            v->write("pResponseStatus", pResponseStatus);
+            v->write("pLongDuration", pLongDuration);
+            v->write("pLongChirpFile", pLongChirpFile);
+            v->write("pLongChirpCmd", pLongChirpCmd);
+            v->write("pLongChirpStatus", pLongChirpStatus);
+            v->write("pLongResponseFile", pLongResponseFile);
+            v->write("pLongResponseStatus", pLongResponseStatus);
+            v->write("pLongMeasureCmd", pLongMeasureCmd);
+            v->write("pLongMeasureStatus", pLongMeasureStatus);
+            v->write("pCaptureSwitch", pCaptureSwitch);
+            v->write("pCaptureStatus", pCaptureStatus);
         }
 
     } /* namespace plugins */
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/dsp-units/units.h>
+#include <lsp-plug.in/stdlib/math.h>
+
+#include <private/plugins/profiler/DecayAnalyzer.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        DecayAnalyzer::DecayAnalyzer()
+        {
+            nRank       = 0;
+            vRe         = NULL;
+            vIm         = NULL;
+            vWindow     = NULL;
+            pData       = NULL;
+        }
+
+        DecayAnalyzer::~DecayAnalyzer()
+        {
+            destroy();
+        }
+
+        status_t DecayAnalyzer::init(size_t rank)
+        {
+            destroy();
+
+            size_t n        = size_t(1) << rank;
+            float *ptr      = alloc_aligned<float>(pData, n * 3);
+            if (ptr == NULL)
+                return STATUS_NO_MEM;
+
+            nRank           = rank;
+            vRe             = ptr;
+            ptr            += n;
+            vIm             = ptr;
+            ptr            += n;
+            vWindow         = ptr;
+            ptr            += n;
+
+            // Flat window with raised cosine fall-off at the last quarter
+            size_t fall     = n >> 2;
+            size_t flat     = n - fall;
+            dsp::fill_one(vWindow, flat);
+            for (size_t i=0; i<fall; ++i)
+                vWindow[flat + i]   = 0.5f + 0.5f * cosf((M_PI * i) / fall);
+
+            return STATUS_OK;
+        }
+
+        void DecayAnalyzer::destroy()
+        {
+            free_aligned(pData);
+            pData       = NULL;
+            vRe         = NULL;
+            vIm         = NULL;
+            vWindow     = NULL;
+            nRank       = 0;
+        }
+
+        void DecayAnalyzer::energy_time_curve(float *dst, size_t points, const float *src, size_t count, float floor)
+        {
+            dsp::fill_zero(dst, points);
+            if ((count <= 0) || (pData == NULL))
+            {
+                dsp::fill(dst, floor, points);
+                return;
+            }
+
+            // The envelope is computed frame by frame. Each frame is twice as long as the hop
+            // and only the middle part of the frame is used to avoid the edge effects.
+            const size_t n      = fft_size();
+            const size_t half   = n >> 1;
+            const size_t hop    = n >> 1;
+            const size_t pre    = n >> 2;
+
+            for (size_t off = 0; off < count; off += hop)
+            {
+                // Fill the frame with samples [off - pre, off - pre + n)
+                ssize_t head    = ssize_t(off) - ssize_t(pre);
+                size_t skip     = (head < 0) ? size_t(-head) : 0;
+                size_t first    = head + skip;
+                size_t to_copy  = lsp_min(n - skip, count - first);
+
+                dsp::fill_zero(vRe, n);
+                dsp::fill_zero(vIm, n);
+                dsp::copy(&vRe[skip], &src[first], to_copy);
+
+                // Analytic signal: double the positive frequencies, drop the negative ones
+                dsp::direct_fft(vRe, vIm, vRe, vIm, nRank);
+                dsp::mul_k2(&vRe[1], 2.0f, half - 1);
+                dsp::mul_k2(&vIm[1], 2.0f, half - 1);
+                dsp::fill_zero(&vRe[half + 1], half - 1);
+                dsp::fill_zero(&vIm[half + 1], half - 1);
+                dsp::reverse_fft(vRe, vIm, vRe, vIm, nRank);
+                dsp::complex_mod(vRe, vRe, vIm, n);
+
+                // Reduce the middle part of the frame to the points
+                size_t to_do    = lsp_min(hop, count - off);
+                const float *env= &vRe[pre];
+                for (size_t i=0; i<to_do; ++i)
+                {
+                    size_t p        = (wsize_t(off + i) * points) / count;
+                    if (env[i] > dst[p])
+                        dst[p]          = env[i];
+                }
+            }
+
+            // Normalize and fill the gaps if the range is shorter than number of points
+            float peak      = dsp::max(dst, points);
+            if (peak > 0.0f)
+                dsp::mul_k2(dst, 1.0f / peak, points);
+            for (size_t i=1; i<points; ++i)
+            {
+                if (dst[i] <= 0.0f)
+                    dst[i]          = dst[i-1];
+            }
+            dsp::limit1(dst, floor, 1.0f, points);
+        }
+
+        float DecayAnalyzer::spectrum(const float *src, size_t count)
+        {
+            if (pData == NULL)
+                return 0.0f;
+
+            const size_t n      = fft_size();
+            size_t to_copy      = lsp_min(n, count);
+
+            dsp::fill_zero(vRe, n);
+            dsp::fill_zero(vIm, n);
+            dsp::mul3(vRe, src, vWindow, to_copy);
+
+            dsp::direct_fft(vRe, vIm, vRe, vIm, nRank);
+            dsp::complex_mod(vRe, vRe, vIm, (n >> 1) + 1);
+
+            return dsp::max(vRe, (n >> 1) + 1);
+        }
+
+        void DecayAnalyzer::map_spectrum(float *dst, size_t cols, size_t sample_rate, float f_min, float f_max, float ref, float range)
+        {
+            if ((pData == NULL) || (ref <= 0.0f) || (sample_rate <= 0))
+            {
+                dsp::fill_zero(dst, cols);
+                return;
+            }
+
+            const size_t n      = fft_size();
+            const size_t bins   = n >> 1;
+            const float kf      = float(n) / float(sample_rate);
+            const float kr      = 1.0f / ref;
+            const float kd      = 1.0f / range;
+            const float lstep   = logf(f_max / f_min) / cols;
+
+            for (size_t i=0; i<cols; ++i)
+            {
+                // Each column takes the peak of all bins that fall into it, or the nearest bin
+                size_t k0       = lsp_min(size_t(f_min * expf(lstep * i) * kf + 0.5f), bins);
+                size_t k1       = lsp_min(size_t(f_min * expf(lstep * (i + 1)) * kf + 0.5f), bins);
+                float v         = (k1 > k0) ? dsp::max(&vRe[k0], k1 - k0) : vRe[k0];
+
+                float db        = (v > 0.0f) ? dspu::gain_to_db(v * kr) : -range;
+                dst[i]          = lsp_limit((db + range) * kd, 0.0f, 1.0f);
+            }
+        }
+
+        void DecayAnalyzer::dump(dspu::IStateDumper *v) const
+        {
+            v->write("nRank", nRank);
+            v->write("vRe", vRe);
+            v->write("vIm", vIm);
+            v->write("vWindow", vWindow);
+            v->write("pData", pData);
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */
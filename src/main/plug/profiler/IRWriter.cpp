@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/debug.h>
+#include <lsp-plug.in/dsp/dsp.h>
+
+#include <private/plugins/profiler/IRWriter.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        IRWriter::IRWriter()
+        {
+            nChannels   = 0;
+            nWritten    = 0;
+            bOpened     = false;
+            vBuffer     = NULL;
+            pData       = NULL;
+        }
+
+        IRWriter::~IRWriter()
+        {
+            close();
+        }
+
+        status_t IRWriter::open(const char *path, size_t channels, size_t sample_rate, size_t frames)
+        {
+            if ((path == NULL) || (channels <= 0))
+                return STATUS_BAD_ARGUMENTS;
+            if (bOpened)
+                return STATUS_OPENED;
+
+            mm::audio_stream_t fmt;
+            fmt.srate       = sample_rate;
+            fmt.channels    = channels;
+            fmt.frames      = frames;
+            fmt.format      = mm::SFMT_F32_CPU;
+
+            status_t res    = sOut.open(path, &fmt, mm::AFMT_WAV | mm::CFMT_PCM);
+            if (res != STATUS_OK)
+                return res;
+
+            nChannels       = channels;
+            nWritten        = 0;
+            bOpened         = true;
+
+            return STATUS_OK;
+        }
+
+        void IRWriter::interleave(float *dst, const dspu::Sample *src, ssize_t first, size_t count)
+        {
+            const size_t channels   = src->channels();
+            const ssize_t head      = lsp_max(first, ssize_t(0));
+            const ssize_t tail      = lsp_min(first + ssize_t(count), ssize_t(src->length()));
+
+            dsp::fill_zero(dst, count * channels);
+            for (size_t ch = 0; ch < channels; ++ch)
+            {
+                const float *s  = src->channel(ch);
+                float *d        = &dst[ch];
+                for (ssize_t i = head; i < tail; ++i)
+                    d[(i - first) * channels] = s[i];
+            }
+        }
+
+        status_t IRWriter::write(const dspu::Sample *src, ssize_t first, size_t count)
+        {
+            if (!bOpened)
+                return STATUS_CLOSED;
+            if (src->channels() != nChannels)
+                return STATUS_BAD_ARGUMENTS;
+
+            // Allocate buffer for one interleaved chunk
+            if (vBuffer == NULL)
+            {
+                vBuffer         = alloc_aligned<float>(pData, CHUNK_SIZE * nChannels);
+                if (vBuffer == NULL)
+                    return STATUS_NO_MEM;
+            }
+
+            while (count > 0)
+            {
+                size_t to_do    = lsp_min(count, CHUNK_SIZE);
+                interleave(vBuffer, src, first, to_do);
+
+                status_t res    = write_interleaved(vBuffer, to_do);
+                if (res != STATUS_OK)
+                    return res;
+
+                first          += to_do;
+                count          -= to_do;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t IRWriter::write_interleaved(const float *src, size_t count)
+        {
+            if (!bOpened)
+                return STATUS_CLOSED;
+
+            // The stream may accept less frames than requested, but should accept at least one
+            for (size_t off = 0; off < count; )
+            {
+                ssize_t n       = sOut.write(&src[off * nChannels], count - off);
+                if (n < 0)
+                    return status_t(-n);
+                else if (n == 0)
+                    return STATUS_IO_ERROR;
+                off            += n;
+            }
+
+            nWritten       += count;
+            return STATUS_OK;
+        }
+
+        status_t IRWriter::close()
+        {
+            status_t res    = STATUS_OK;
+            if (bOpened)
+            {
+                res             = sOut.close();
+                bOpened         = false;
+            }
+
+            free_aligned(pData);
+            vBuffer         = NULL;
+            nChannels       = 0;
+
+            return res;
+        }
+
+        void IRWriter::dump(dspu::IStateDumper *v) const
+        {
+            v->write("nChannels", nChannels);
+            v->write("nWritten", nWritten);
+            v->write("bOpened", bOpened);
+            v->write("vBuffer", vBuffer);
+            v->write("pData", pData);
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */
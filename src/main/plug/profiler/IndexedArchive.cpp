@@ -0,0 +1,392 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/endian.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <private/plugins/profiler/IndexedArchive.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        IndexedArchive::IndexedArchive()
+        {
+            bzero(&sHeader, sizeof(sHeader));
+            bzero(vEntries, sizeof(vEntries));
+            bOpened     = false;
+            bWriting    = false;
+            bCompress   = false;
+            vBuffer     = NULL;
+            nCapacity   = 0;
+        }
+
+        IndexedArchive::~IndexedArchive()
+        {
+            close();
+
+            if (vBuffer != NULL)
+            {
+                free(vBuffer);
+                vBuffer     = NULL;
+            }
+            nCapacity   = 0;
+        }
+
+        void IndexedArchive::swap_header(header_t *h)
+        {
+            h->magic        = CPU_TO_LE(h->magic);
+            h->version      = CPU_TO_LE(h->version);
+            h->entries      = CPU_TO_LE(h->entries);
+            h->flags        = CPU_TO_LE(h->flags);
+            h->index        = CPU_TO_LE(h->index);
+        }
+
+        void IndexedArchive::swap_entry(entry_t *e)
+        {
+            e->type         = CPU_TO_LE(e->type);
+            e->channel      = CPU_TO_LE(e->channel);
+            e->harmonic     = CPU_TO_LE(e->harmonic);
+            e->codec        = CPU_TO_LE(e->codec);
+            e->flags        = CPU_TO_LE(e->flags);
+            e->position     = CPU_TO_LE(e->position);
+            e->offset       = CPU_TO_LE(e->offset);
+            e->size         = CPU_TO_LE(e->size);
+            e->length       = CPU_TO_LE(e->length);
+        }
+
+        status_t IndexedArchive::reserve(size_t bytes)
+        {
+            if (bytes <= nCapacity)
+                return STATUS_OK;
+
+            uint8_t *ptr    = static_cast<uint8_t *>(realloc(vBuffer, bytes));
+            if (ptr == NULL)
+                return STATUS_NO_MEM;
+
+            vBuffer         = ptr;
+            nCapacity       = bytes;
+            return STATUS_OK;
+        }
+
+        status_t IndexedArchive::write_fully(const void *data, size_t bytes)
+        {
+            const uint8_t *src  = static_cast<const uint8_t *>(data);
+            while (bytes > 0)
+            {
+                ssize_t n       = sFile.write(src, bytes);
+                if (n <= 0)
+                    return (n < 0) ? status_t(-n) : STATUS_IO_ERROR;
+                src            += n;
+                bytes          -= n;
+            }
+            return STATUS_OK;
+        }
+
+        status_t IndexedArchive::read_fully(void *data, size_t bytes)
+        {
+            uint8_t *dst    = static_cast<uint8_t *>(data);
+            while (bytes > 0)
+            {
+                ssize_t n       = sFile.read(dst, bytes);
+                if (n <= 0)
+                    return (n < 0) ? status_t(-n) : STATUS_CORRUPTED_FILE;
+                dst            += n;
+                bytes          -= n;
+            }
+            return STATUS_OK;
+        }
+
+        size_t IndexedArchive::pack(uint8_t *dst, const uint32_t *src, size_t count)
+        {
+            // Each pair of words is preceded by the control byte holding the number
+            // of significant bytes of each word in its nibbles
+            uint8_t *p      = dst;
+            uint32_t prev   = 0;
+            for (size_t i=0; i<count; i += 2)
+            {
+                uint8_t *ctl    = p++;
+                *ctl            = 0;
+                for (size_t j=0; (j < 2) && ((i + j) < count); ++j)
+                {
+                    uint32_t w      = CPU_TO_LE(src[i + j]);
+                    uint32_t x      = w ^ prev;
+                    prev            = w;
+
+                    size_t n        = 0;
+                    for ( ; x != 0; x >>= 8)
+                        p[n++]          = uint8_t(x & 0xff);
+                    p              += n;
+                    *ctl           |= uint8_t(n << (j * 4));
+                }
+            }
+
+            return p - dst;
+        }
+
+        bool IndexedArchive::unpack(uint32_t *dst, size_t count, const uint8_t *src, size_t size)
+        {
+            const uint8_t *end  = &src[size];
+            uint32_t prev   = 0;
+            for (size_t i=0; i<count; i += 2)
+            {
+                if (src >= end)
+                    return false;
+                uint8_t ctl     = *(src++);
+
+                for (size_t j=0; (j < 2) && ((i + j) < count); ++j)
+                {
+                    size_t n        = (ctl >> (j * 4)) & 0x0f;
+                    if ((n > 4) || ((src + n) > end))
+                        return false;
+
+                    uint32_t x      = 0;
+                    for (size_t k=0; k<n; ++k)
+                        x              |= uint32_t(src[k]) << (k * 8);
+                    src            += n;
+
+                    prev           ^= x;
+                    dst[i + j]      = LE_TO_CPU(prev);
+                }
+            }
+
+            return src == end;
+        }
+
+        status_t IndexedArchive::create(const char *path, bool compress)
+        {
+            if (bOpened)
+                return STATUS_OPENED;
+
+            status_t res    = sFile.open(path, io::File::FM_WRITE_NEW);
+            if (res != STATUS_OK)
+                return res;
+
+            // Reserve space for the header, it is written when the archive is closed
+            bzero(&sHeader, sizeof(sHeader));
+            if ((res = write_fully(&sHeader, sizeof(sHeader))) != STATUS_OK)
+            {
+                sFile.close();
+                return res;
+            }
+
+            bOpened         = true;
+            bWriting        = true;
+            bCompress       = compress;
+            return STATUS_OK;
+        }
+
+        status_t IndexedArchive::write(chunk_type_t type, size_t channel, size_t harmonic, ssize_t position,
+            const void *data, size_t count)
+        {
+            if ((!bOpened) || (!bWriting))
+                return STATUS_BAD_STATE;
+            if (sHeader.entries >= ENTRIES_MAX)
+                return STATUS_OVERFLOW;
+
+            wssize_t offset = sFile.position();
+            if (offset < 0)
+                return status_t(-offset);
+
+            entry_t *e      = &vEntries[sHeader.entries];
+            e->type         = type;
+            e->channel      = channel;
+            e->harmonic     = harmonic;
+            e->codec        = CODEC_RAW;
+            e->flags        = 0;
+            e->position     = position;
+            e->offset       = offset;
+            e->size         = count * sizeof(uint32_t);
+            e->length       = count * sizeof(uint32_t);
+
+            // Pack the payload, keep it as is if packing does not make it smaller
+            const void *payload = data;
+            if (bCompress)
+            {
+                // Worst case is one control byte per two words of four bytes
+                status_t res    = reserve(count * sizeof(uint32_t) + (count + 1) / 2);
+                if (res != STATUS_OK)
+                    return res;
+
+                size_t size     = pack(vBuffer, static_cast<const uint32_t *>(data), count);
+                if (size < e->length)
+                {
+                    e->codec        = CODEC_XOR_PACK;
+                    e->size         = size;
+                    payload         = vBuffer;
+                }
+            }
+
+            status_t res    = write_fully(payload, e->size);
+            if (res != STATUS_OK)
+                return res;
+
+            ++sHeader.entries;
+            return STATUS_OK;
+        }
+
+        status_t IndexedArchive::open(const char *path)
+        {
+            if (bOpened)
+                return STATUS_OPENED;
+
+            status_t res    = sFile.open(path, io::File::FM_READ);
+            if (res != STATUS_OK)
+                return res;
+
+            // Read the header and the index only
+            if ((res = read_fully(&sHeader, sizeof(sHeader))) == STATUS_OK)
+            {
+                swap_header(&sHeader);
+                if ((sHeader.magic != MAGIC) || (sHeader.version != VERSION))
+                    res             = STATUS_BAD_FORMAT;
+                else if (sHeader.entries > ENTRIES_MAX)
+                    res             = STATUS_CORRUPTED_FILE;
+                else
+                    res             = sFile.seek(sHeader.index, io::File::FSK_SET);
+            }
+            if (res == STATUS_OK)
+                res             = read_fully(vEntries, sHeader.entries * sizeof(entry_t));
+            if (res != STATUS_OK)
+            {
+                bzero(&sHeader, sizeof(sHeader));
+                sFile.close();
+                return res;
+            }
+
+            for (size_t i=0; i<sHeader.entries; ++i)
+                swap_entry(&vEntries[i]);
+
+            bOpened         = true;
+            bWriting        = false;
+            bCompress       = false;
+            return STATUS_OK;
+        }
+
+        const IndexedArchive::entry_t *IndexedArchive::find(chunk_type_t type, size_t channel, size_t harmonic) const
+        {
+            for (size_t i=0; i<sHeader.entries; ++i)
+            {
+                const entry_t *e    = &vEntries[i];
+                if ((e->type != uint32_t(type)) || (e->channel != channel))
+                    continue;
+                if ((type == CT_IR) && (e->harmonic != harmonic))
+                    continue;
+                return e;
+            }
+
+            return NULL;
+        }
+
+        status_t IndexedArchive::read(const entry_t *entry, void *dst)
+        {
+            if ((!bOpened) || (bWriting))
+                return STATUS_BAD_STATE;
+            if ((entry == NULL) || (entry->length % sizeof(uint32_t)))
+                return STATUS_BAD_ARGUMENTS;
+
+            status_t res    = sFile.seek(entry->offset, io::File::FSK_SET);
+            if (res != STATUS_OK)
+                return res;
+
+            switch (entry->codec)
+            {
+                case CODEC_RAW:
+                    if (entry->size != entry->length)
+                        return STATUS_CORRUPTED_FILE;
+                    return read_fully(dst, entry->size);
+
+                case CODEC_XOR_PACK:
+                    if ((res = reserve(entry->size)) != STATUS_OK)
+                        return res;
+                    if ((res = read_fully(vBuffer, entry->size)) != STATUS_OK)
+                        return res;
+                    if (!unpack(static_cast<uint32_t *>(dst), entry->length / sizeof(uint32_t), vBuffer, entry->size))
+                        return STATUS_CORRUPTED_FILE;
+                    return STATUS_OK;
+
+                default:
+                    break;
+            }
+
+            return STATUS_UNSUPPORTED_FORMAT;
+        }
+
+        status_t IndexedArchive::close()
+        {
+            if (!bOpened)
+                return STATUS_OK;
+
+            status_t res    = STATUS_OK;
+            if (bWriting)
+            {
+                // Append the index and update the header
+                wssize_t index  = sFile.position();
+                if (index < 0)
+                    res             = status_t(-index);
+
+                size_t entries  = sHeader.entries;
+                for (size_t i=0; (res == STATUS_OK) && (i<entries); ++i)
+                {
+                    entry_t e       = vEntries[i];
+                    swap_entry(&e);
+                    res             = write_fully(&e, sizeof(e));
+                }
+
+                if (res == STATUS_OK)
+                    res             = sFile.seek(0, io::File::FSK_SET);
+                if (res == STATUS_OK)
+                {
+                    header_t h;
+                    h.magic         = MAGIC;
+                    h.version       = VERSION;
+                    h.entries       = entries;
+                    h.flags         = 0;
+                    h.index         = index;
+                    swap_header(&h);
+                    res             = write_fully(&h, sizeof(h));
+                }
+            }
+
+            status_t xres   = sFile.close();
+            if (res == STATUS_OK)
+                res             = xres;
+
+            bzero(&sHeader, sizeof(sHeader));
+            bOpened         = false;
+            bWriting        = false;
+
+            return res;
+        }
+
+        void IndexedArchive::dump(dspu::IStateDumper *v) const
+        {
+            v->write("entries", size_t(sHeader.entries));
+            v->write("bOpened", bOpened);
+            v->write("bWriting", bWriting);
+            v->write("bCompress", bCompress);
+            v->write("vBuffer", vBuffer);
+            v->write("nCapacity", nCapacity);
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */
@@ -0,0 +1,311 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/debug.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/dsp-units/units.h>
+#include <lsp-plug.in/mm/InAudioFileStream.h>
+#include <lsp-plug.in/stdlib/math.h>
+
+#include <private/plugins/profiler/IRWriter.h>
+#include <private/plugins/profiler/LongSweep.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        LongSweep::LongSweep()
+        {
+            nSampleRate     = 0;
+            nLength         = 0;
+            fInitialFreq    = 0.0;
+            fFinalFreq      = 0.0;
+            fRate           = 0.0;
+            fAmplitude      = 1.0f;
+            fNorm           = 0.0f;
+        }
+
+        LongSweep::~LongSweep()
+        {
+        }
+
+        status_t LongSweep::init(size_t sample_rate, float initial_freq, float final_freq, float duration, float amplitude)
+        {
+            // Keep the final frequency below the Nyquist frequency
+            final_freq      = lsp_min(final_freq, 0.45f * sample_rate);
+            if ((sample_rate <= 0) || (initial_freq <= 0.0f) || (final_freq <= initial_freq) ||
+                (duration <= 0.0f) || (amplitude <= 0.0f))
+                return STATUS_BAD_ARGUMENTS;
+
+            nSampleRate     = sample_rate;
+            nLength         = wsize_t(double(duration) * sample_rate);
+            fInitialFreq    = initial_freq;
+            fFinalFreq      = final_freq;
+            fRate           = double(nLength) / log(fFinalFreq / fInitialFreq);
+            fAmplitude      = amplitude;
+
+            // The magnitude spectrum of the sweep is proportional to sqrt(L/f), the inverse filter
+            // has the envelope proportional to f, so the product is flat in the band of the sweep
+            fNorm           = float(4.0 * fFinalFreq / (double(nSampleRate) * fRate * amplitude));
+
+            return STATUS_OK;
+        }
+
+        double LongSweep::phase(wsize_t n) const
+        {
+            return 2.0 * M_PI * fInitialFreq * fRate * (exp(double(n) / fRate) - 1.0) / nSampleRate;
+        }
+
+        void LongSweep::chirp(float *dst, wsize_t offset, size_t count) const
+        {
+            const double fade_in    = FADE_IN * nSampleRate;
+            const double fade_out   = FADE_OUT * nSampleRate;
+
+            for (size_t i=0; i<count; ++i)
+            {
+                wsize_t n       = offset + i;
+                if (n >= nLength)
+                {
+                    dsp::fill_zero(&dst[i], count - i);
+                    break;
+                }
+
+                // Raised cosine fades at both ends of the chirp
+                double v        = fAmplitude * sin(phase(n));
+                double tail     = double(nLength - 1 - n);
+                if (n < fade_in)
+                    v              *= 0.5 * (1.0 - cos(M_PI * n / fade_in));
+                if (tail < fade_out)
+                    v              *= 0.5 * (1.0 - cos(M_PI * tail / fade_out));
+
+                dst[i]          = float(v);
+            }
+        }
+
+        void LongSweep::inverse(float *dst, wsize_t offset, size_t count) const
+        {
+            for (size_t i=0; i<count; ++i)
+            {
+                wsize_t n       = offset + i;
+                if (n >= nLength)
+                {
+                    dsp::fill_zero(&dst[i], count - i);
+                    break;
+                }
+
+                // Time-reversed sweep with the envelope falling by 6 dB per octave
+                dst[i]          = float(sin(phase(nLength - 1 - n)) * exp(-double(n) / fRate) * fNorm);
+            }
+        }
+
+        status_t LongSweep::export_chirp(const char *path) const
+        {
+            if (nLength <= 0)
+                return STATUS_BAD_STATE;
+
+            uint8_t *data   = NULL;
+            float *buf      = alloc_aligned<float>(data, IRWriter::CHUNK_SIZE);
+            if (buf == NULL)
+                return STATUS_NO_MEM;
+
+            IRWriter wr;
+            status_t res    = wr.open(path, 1, nSampleRate, nLength);
+            for (wsize_t off = 0; (res == STATUS_OK) && (off < nLength); )
+            {
+                size_t n        = lsp_min(nLength - off, wsize_t(IRWriter::CHUNK_SIZE));
+                chirp(buf, off, n);
+                res             = wr.write_interleaved(buf, n);
+                off            += n;
+            }
+
+            status_t xres   = wr.close();
+            free_aligned(data);
+            return (res == STATUS_OK) ? xres : res;
+        }
+
+        status_t LongSweep::deconvolve(const char *response, const char *ir) const
+        {
+            if (nLength <= 0)
+                return STATUS_BAD_STATE;
+
+            mm::InAudioFileStream is;
+            status_t res    = is.open(response);
+            if (res != STATUS_OK)
+                return res;
+
+            const size_t channels   = is.channels();
+            if ((is.sample_rate() != nSampleRate) || (channels <= 0))
+            {
+                is.close();
+                return STATUS_BAD_FORMAT;
+            }
+
+            // The linear response starts at the last sample of the chirp, only the window
+            // [first, last) of the convolution is computed. The block pair (i, j) of the
+            // response and the filter contributes to the samples [(i+j)*P, (i+j+2)*P).
+            const size_t P          = PARTITION;
+            const size_t rank       = PARTITION_RANK + 1;
+            const size_t fsize      = P * 4;                    // Size of the fast convolution spectrum
+            wssize_t frames         = is.length();
+            wsize_t tail            = dspu::seconds_to_samples(nSampleRate, TAIL_MAX);
+            if (frames > 0)
+                tail                    = lsp_min(tail, wsize_t(frames));
+
+            const wsize_t first     = nLength - 1;
+            const wsize_t last      = first + tail;
+            const wsize_t o_min     = (first >= P) ? first / P - 1 : 0;
+            const wsize_t o_max     = (last - 1) / P;
+            const size_t slots      = o_max - o_min + 1;
+            const wsize_t blocks    = (nLength + P - 1) / P;
+
+            // Spectra of the filter blocks are cached: for each block of the response the needed
+            // filter blocks shift by one, so each filter block is computed only once
+            uint8_t *data   = NULL;
+            float *ptr      = alloc_aligned<float>(data,
+                slots * fsize +                         // Cache of filter spectra
+                channels * fsize +                      // Spectra of the response block
+                channels * (slots + 1) * P +            // Output window
+                fsize +                                 // Temporary buffer of the fast convolution
+                channels * P +                          // Interleaved response block
+                P);                                     // One channel of the block
+            wssize_t *tags  = static_cast<wssize_t *>(malloc(slots * sizeof(wssize_t)));
+            if ((ptr == NULL) || (tags == NULL))
+            {
+                free(tags);
+                free_aligned(data);
+                is.close();
+                return STATUS_NO_MEM;
+            }
+
+            float *cache    = ptr;
+            ptr            += slots * fsize;
+            float *spec     = ptr;
+            ptr            += channels * fsize;
+            float *out      = ptr;
+            ptr            += channels * (slots + 1) * P;
+            float *tmp      = ptr;
+            ptr            += fsize;
+            float *in       = ptr;
+            ptr            += channels * P;
+            float *blk      = ptr;
+
+            for (size_t i=0; i<slots; ++i)
+                tags[i]         = -1;
+            dsp::fill_zero(out, channels * (slots + 1) * P);
+
+            // Blocks of the response after o_max do not contribute to the window
+            for (wsize_t i=0; (res == STATUS_OK) && (i <= o_max); ++i)
+            {
+                // Read the whole block, the missing part is zero
+                size_t count    = 0;
+                while (count < P)
+                {
+                    ssize_t n       = is.read(&in[count * channels], P - count);
+                    if (n <= 0)
+                    {
+                        if ((n != -STATUS_EOF) && (n != 0))
+                            res             = status_t(-n);
+                        break;
+                    }
+                    count          += n;
+                }
+                if ((res != STATUS_OK) || (count <= 0))
+                    break;
+                dsp::fill_zero(&in[count * channels], (P - count) * channels);
+
+                for (size_t ch=0; ch<channels; ++ch)
+                {
+                    const float *src    = &in[ch];
+                    for (size_t k=0; k<P; ++k, src += channels)
+                        blk[k]              = *src;
+                    dsp::fastconv_parse(&spec[ch * fsize], blk, rank);
+                }
+
+                wsize_t o_lo    = lsp_max(o_min, i);
+                wsize_t o_hi    = lsp_min(o_max, i + blocks - 1);
+                for (wsize_t o = o_lo; o <= o_hi; ++o)
+                {
+                    wsize_t j       = o - i;
+                    size_t slot     = j % slots;
+                    float *h        = &cache[slot * fsize];
+                    if (tags[slot] != wssize_t(j))
+                    {
+                        inverse(blk, j * P, P);
+                        dsp::fastconv_parse(h, blk, rank);
+                        tags[slot]      = j;
+                    }
+
+                    for (size_t ch=0; ch<channels; ++ch)
+                        dsp::fastconv_apply(&out[ch * (slots + 1) * P + (o - o_min) * P], tmp, &spec[ch * fsize], h, rank);
+                }
+
+                if (count < P)
+                    break;
+            }
+
+            status_t xres   = is.close();
+            if (res == STATUS_OK)
+                res             = xres;
+
+            // Save the window starting from the time origin
+            if (res == STATUS_OK)
+            {
+                IRWriter wr;
+                lsp_trace("Saving long sweep impulse response to path = %s", ir);
+                res             = wr.open(ir, channels, nSampleRate, tail);
+                for (wsize_t off = 0; (res == STATUS_OK) && (off < tail); )
+                {
+                    size_t n        = lsp_min(tail - off, wsize_t(P));
+                    for (size_t ch=0; ch<channels; ++ch)
+                    {
+                        const float *src    = &out[ch * (slots + 1) * P + (first - o_min * P) + off];
+                        float *dst          = &in[ch];
+                        for (size_t k=0; k<n; ++k, dst += channels)
+                            *dst                = src[k];
+                    }
+                    res             = wr.write_interleaved(in, n);
+                    off            += n;
+                }
+
+                xres            = wr.close();
+                if (res == STATUS_OK)
+                    res             = xres;
+            }
+
+            free(tags);
+            free_aligned(data);
+            return res;
+        }
+
+        void LongSweep::dump(dspu::IStateDumper *v) const
+        {
+            v->write("nSampleRate", nSampleRate);
+            v->write("nLength", nLength);
+            v->write("fInitialFreq", fInitialFreq);
+            v->write("fFinalFreq", fFinalFreq);
+            v->write("fRate", fRate);
+            v->write("fAmplitude", fAmplitude);
+            v->write("fNorm", fNorm);
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */
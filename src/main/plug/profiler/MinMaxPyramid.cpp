@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/math.h>
+
+#include <private/plugins/profiler/MinMaxPyramid.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        MinMaxPyramid::MinMaxPyramid()
+        {
+            pSrc        = NULL;
+            nLength     = 0;
+            nLevels     = 0;
+            nCapacity   = 0;
+            fAbsMax     = 0.0f;
+            vData       = NULL;
+            pData       = NULL;
+
+            for (size_t i=0; i<LEVELS_MAX; ++i)
+            {
+                vMin[i]     = NULL;
+                vMax[i]     = NULL;
+                vLength[i]  = 0;
+            }
+        }
+
+        MinMaxPyramid::~MinMaxPyramid()
+        {
+            destroy();
+        }
+
+        void MinMaxPyramid::destroy()
+        {
+            clear();
+
+            free_aligned(pData);
+            pData       = NULL;
+            vData       = NULL;
+            nCapacity   = 0;
+        }
+
+        void MinMaxPyramid::clear()
+        {
+            pSrc        = NULL;
+            nLength     = 0;
+            nLevels     = 0;
+            fAbsMax     = 0.0f;
+
+            for (size_t i=0; i<LEVELS_MAX; ++i)
+            {
+                vMin[i]     = NULL;
+                vMax[i]     = NULL;
+                vLength[i]  = 0;
+            }
+        }
+
+        status_t MinMaxPyramid::build(const float *src, size_t count)
+        {
+            clear();
+            if ((src == NULL) || (count <= 0))
+                return STATUS_OK;
+
+            // Estimate the size of all levels
+            size_t levels   = 0;
+            size_t capacity = 0;
+            for (size_t len = count; (len > 1) && (levels < (LEVELS_MAX - 1)); )
+            {
+                len             = (len + MASK) >> SHIFT;
+                capacity       += align_size(len, size_t(DEFAULT_ALIGN));
+                ++levels;
+            }
+
+            // Grow the storage only if it is not enough to keep the pyramid
+            if (capacity > nCapacity)
+            {
+                uint8_t *data   = NULL;
+                float *ptr      = alloc_aligned<float>(data, capacity * 2);
+                if (ptr == NULL)
+                    return STATUS_NO_MEM;
+
+                free_aligned(pData);
+                pData           = data;
+                vData           = ptr;
+                nCapacity       = capacity;
+            }
+
+            // Bind the levels
+            float *ptr      = vData;
+            vLength[0]      = count;
+            for (size_t l=1; l <= levels; ++l)
+            {
+                vLength[l]      = (vLength[l-1] + MASK) >> SHIFT;
+                vMin[l]         = ptr;
+                ptr            += align_size(vLength[l], size_t(DEFAULT_ALIGN));
+                vMax[l]         = ptr;
+                ptr            += align_size(vLength[l], size_t(DEFAULT_ALIGN));
+            }
+
+            // Build the first level from the source signal
+            if (levels > 0)
+            {
+                float *dmin     = vMin[1];
+                float *dmax     = vMax[1];
+                for (size_t i=0, off=0; off < count; ++i, off += FACTOR)
+                    dsp::minmax(&src[off], lsp_min(count - off, FACTOR), &dmin[i], &dmax[i]);
+            }
+
+            // Build all other levels
+            for (size_t l=2; l <= levels; ++l)
+            {
+                const float *smin   = vMin[l-1];
+                const float *smax   = vMax[l-1];
+                float *dmin         = vMin[l];
+                float *dmax         = vMax[l];
+                size_t slen         = vLength[l-1];
+
+                for (size_t i=0, off=0; off < slen; ++i, off += FACTOR)
+                {
+                    size_t n            = lsp_min(slen - off, FACTOR);
+                    dmin[i]             = dsp::min(&smin[off], n);
+                    dmax[i]             = dsp::max(&smax[off], n);
+                }
+            }
+
+            pSrc            = src;
+            nLength         = count;
+            nLevels         = levels;
+
+            if (levels > 0)
+                fAbsMax         = lsp_max(
+                    fabsf(dsp::min(vMin[levels], vLength[levels])),
+                    fabsf(dsp::max(vMax[levels], vLength[levels])));
+            else
+                fAbsMax         = dsp::abs_max(src, count);
+
+            return STATUS_OK;
+        }
+
+        void MinMaxPyramid::reduce(size_t level, size_t index, float *min, float *max) const
+        {
+            float vmin, vmax;
+            if (level <= 0)
+            {
+                vmin            = pSrc[index];
+                vmax            = vmin;
+            }
+            else
+            {
+                vmin            = vMin[level][index];
+                vmax            = vMax[level][index];
+            }
+
+            if (vmin < *min)
+                *min            = vmin;
+            if (vmax > *max)
+                *max            = vmax;
+        }
+
+        bool MinMaxPyramid::get_minmax(ssize_t first, ssize_t last, float *min, float *max) const
+        {
+            if (pSrc == NULL)
+                return false;
+
+            // Clip the range to the signal
+            first           = lsp_max(first, ssize_t(0));
+            last            = lsp_min(last, ssize_t(nLength));
+            if (first >= last)
+                return false;
+
+            float vmin      = pSrc[first];
+            float vmax      = vmin;
+
+            // Reduce the unaligned head and tail of the range at the current level,
+            // then climb to the next level for the aligned part
+            size_t a        = first;
+            size_t b        = last;
+            for (size_t l=0; a < b; ++l)
+            {
+                if (l >= nLevels)
+                {
+                    for ( ; a < b; ++a)
+                        reduce(l, a, &vmin, &vmax);
+                    break;
+                }
+
+                for ( ; (a & MASK) && (a < b); ++a)
+                    reduce(l, a, &vmin, &vmax);
+                for ( ; (b & MASK) && (a < b); )
+                    reduce(l, --b, &vmin, &vmax);
+
+                a             >>= SHIFT;
+                b             >>= SHIFT;
+            }
+
+            *min            = vmin;
+            *max            = vmax;
+
+            return true;
+        }
+
+        void MinMaxPyramid::get_peaks(float *dst, ssize_t first, size_t count, size_t points, bool normalize) const
+        {
+            if (points <= 0)
+                return;
+            if ((pSrc == NULL) || (count <= 0))
+            {
+                dsp::fill_zero(dst, points);
+                return;
+            }
+
+            float norm      = ((normalize) && (fAbsMax > 0.0f)) ? 1.0f / fAbsMax : 1.0f;
+            float vmin, vmax;
+
+            for (size_t i=0; i<points; ++i)
+            {
+                ssize_t a       = first + (wssize_t(i) * count) / points;
+                ssize_t b       = first + (wssize_t(i + 1) * count) / points;
+                if (b <= a)
+                    b               = a + 1; // The range is shorter than the number of points
+
+                if (get_minmax(a, b, &vmin, &vmax))
+                    dst[i]          = ((vmax >= -vmin) ? vmax : vmin) * norm;
+                else
+                    dst[i]          = 0.0f;
+            }
+        }
+
+        void MinMaxPyramid::dump(dspu::IStateDumper *v) const
+        {
+            v->write("pSrc", pSrc);
+            v->write("nLength", nLength);
+            v->write("nLevels", nLevels);
+            v->write("nCapacity", nCapacity);
+            v->write("fAbsMax", fAbsMax);
+            v->writev("vLength", vLength, LEVELS_MAX);
+            v->write("vData", vData);
+            v->write("pData", pData);
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/debug.h>
+#include <lsp-plug.in/common/endian.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/io/NativeFile.h>
+#include <lsp-plug.in/runtime/system.h>
+#include <lsp-plug.in/stdlib/math.h>
+
+#include <private/plugins/profiler/PartitionTuner.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        static inline wsize_t elapsed_nanos(const system::time_t *start)
+        {
+            system::time_t t;
+            system::get_time(&t);
+            return wsize_t(t.seconds - start->seconds) * 1000000000 + t.nanos - start->nanos;
+        }
+
+        PartitionTuner::PartitionTuner()
+        {
+            for (size_t i=0; i<RANKS; ++i)
+            {
+                vParse[i]       = 0;
+                vApply[i]       = 0;
+            }
+            bReady          = false;
+        }
+
+        PartitionTuner::~PartitionTuner()
+        {
+        }
+
+        status_t PartitionTuner::measure(size_t rank, uint32_t *parse, uint32_t *apply)
+        {
+            // The working set is the same as for the partitioned convolution: spectra of
+            // several filter blocks, the spectrum of the response block and the output
+            const size_t P      = 1 << rank;
+            const size_t frank  = rank + 1;
+            const size_t fsize  = P * 4;
+
+            uint8_t *data   = NULL;
+            float *ptr      = alloc_aligned<float>(data, (BENCH_BLOCKS + 2) * fsize + P * (BENCH_BLOCKS + 1));
+            if (ptr == NULL)
+                return STATUS_NO_MEM;
+
+            float *filter   = ptr;
+            ptr            += BENCH_BLOCKS * fsize;
+            float *spec     = ptr;
+            ptr            += fsize;
+            float *tmp      = ptr;
+            ptr            += fsize;
+            float *out      = ptr;
+
+            // The signal is a decaying sawtooth, the contents do not matter for the timing
+            for (size_t i=0; i<P; ++i)
+                out[i]          = float(i & 0xff) / float(i + 1);
+            dsp::fill_zero(&out[P], P * BENCH_BLOCKS);
+
+            system::time_t start;
+            size_t reps     = 0;
+            system::get_time(&start);
+            wsize_t t       = 0;
+            for ( ; (reps < BENCH_BLOCKS) || (t < BENCH_TIME); ++reps)
+            {
+                dsp::fastconv_parse(&filter[(reps % BENCH_BLOCKS) * fsize], out, frank);
+                t               = elapsed_nanos(&start);
+            }
+            *parse          = uint32_t(lsp_min(t / reps, wsize_t(UINT32_MAX)));
+
+            dsp::fastconv_parse(spec, out, frank);
+            reps            = 0;
+            system::get_time(&start);
+            t               = 0;
+            for ( ; (reps < BENCH_BLOCKS) || (t < BENCH_TIME); ++reps)
+            {
+                size_t j        = reps % BENCH_BLOCKS;
+                dsp::fastconv_apply(&out[j * P], tmp, spec, &filter[j * fsize], frank);
+                t               = elapsed_nanos(&start);
+            }
+            *apply          = uint32_t(lsp_min(t / reps, wsize_t(UINT32_MAX)));
+
+            free_aligned(data);
+            return STATUS_OK;
+        }
+
+        status_t PartitionTuner::benchmark()
+        {
+            bReady          = false;
+            for (size_t i=0; i<RANKS; ++i)
+            {
+                status_t res    = measure(RANK_MIN + i, &vParse[i], &vApply[i]);
+                if (res != STATUS_OK)
+                    return res;
+                lsp_trace("partition rank=%d parse=%d ns apply=%d ns",
+                    int(RANK_MIN + i), int(vParse[i]), int(vApply[i]));
+            }
+            bReady          = true;
+
+            return STATUS_OK;
+        }
+
+        status_t PartitionTuner::load(const char *path)
+        {
+            io::NativeFile fd;
+            status_t res    = fd.open(path, io::File::FM_READ);
+            if (res != STATUS_OK)
+                return res;
+
+            wisdom_t w;
+            ssize_t n       = fd.read(&w, sizeof(w));
+            status_t xres   = fd.close();
+            if (n != ssize_t(sizeof(w)))
+                return (n < 0) ? status_t(-n) : STATUS_CORRUPTED_FILE;
+            if (xres != STATUS_OK)
+                return xres;
+
+            // The wisdom of other set of partitions is measured again
+            if ((LE_TO_CPU(w.magic) != MAGIC) || (LE_TO_CPU(w.version) != VERSION) ||
+                (LE_TO_CPU(w.rank_min) != RANK_MIN) || (LE_TO_CPU(w.ranks) != RANKS))
+                return STATUS_BAD_FORMAT;
+
+            for (size_t i=0; i<RANKS; ++i)
+            {
+                uint32_t parse  = LE_TO_CPU(w.parse[i]);
+                uint32_t apply  = LE_TO_CPU(w.apply[i]);
+                if ((parse <= 0) || (apply <= 0))
+                    return STATUS_CORRUPTED_FILE;
+                vParse[i]       = parse;
+                vApply[i]       = apply;
+            }
+            bReady          = true;
+
+            return STATUS_OK;
+        }
+
+        status_t PartitionTuner::save(const char *path) const
+        {
+            if (!bReady)
+                return STATUS_BAD_STATE;
+
+            wisdom_t w;
+            w.magic         = CPU_TO_LE(MAGIC);
+            w.version       = CPU_TO_LE(VERSION);
+            w.rank_min      = CPU_TO_LE(uint32_t(RANK_MIN));
+            w.ranks         = CPU_TO_LE(uint32_t(RANKS));
+            for (size_t i=0; i<RANKS; ++i)
+            {
+                w.parse[i]      = CPU_TO_LE(vParse[i]);
+                w.apply[i]      = CPU_TO_LE(vApply[i]);
+            }
+
+            io::NativeFile fd;
+            status_t res    = fd.open(path, io::File::FM_WRITE_NEW);
+            if (res != STATUS_OK)
+                return res;
+
+            ssize_t n       = fd.write(&w, sizeof(w));
+            status_t xres   = fd.close();
+            if (n != ssize_t(sizeof(w)))
+                return (n < 0) ? status_t(-n) : STATUS_IO_ERROR;
+
+            return xres;
+        }
+
+        size_t PartitionTuner::partition(size_t length, size_t filter) const
+        {
+            if ((!bReady) || (length <= 0) || (filter <= 0))
+                return 0;
+
+            // Each block of the response and each block of the filter is parsed once,
+            // each pair of blocks is convolved
+            size_t best     = 0;
+            double cost     = 0.0;
+            for (size_t i=0; i<RANKS; ++i)
+            {
+                const size_t P  = size_t(1) << (RANK_MIN + i);
+                double nr       = (length + P - 1) / P;
+                double nf       = (filter + P - 1) / P;
+                double c        = (nr + nf) * vParse[i] + nr * nf * vApply[i];
+                if ((best <= 0) || (c < cost))
+                {
+                    best            = P;
+                    cost            = c;
+                }
+            }
+
+            return best;
+        }
+
+        void PartitionTuner::dump(dspu::IStateDumper *v) const
+        {
+            v->writev("vParse", vParse, RANKS);
+            v->writev("vApply", vApply, RANKS);
+            v->write("bReady", bReady);
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */
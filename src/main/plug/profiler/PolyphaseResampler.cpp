@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/math.h>
+
+#include <private/plugins/profiler/PolyphaseResampler.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        PolyphaseResampler::PolyphaseResampler()
+        {
+            nUp         = 0;
+            nDown       = 0;
+            nTaps       = 0;
+            vPhases     = NULL;
+            pData       = NULL;
+        }
+
+        PolyphaseResampler::~PolyphaseResampler()
+        {
+            destroy();
+        }
+
+        void PolyphaseResampler::destroy()
+        {
+            free_aligned(pData);
+            pData       = NULL;
+            vPhases     = NULL;
+            nUp         = 0;
+            nDown       = 0;
+            nTaps       = 0;
+        }
+
+        double PolyphaseResampler::bessel_i0(double x)
+        {
+            // Power series of the modified Bessel function of the first kind
+            double sum      = 1.0;
+            double term     = 1.0;
+            double q        = x * x * 0.25;
+            for (size_t k=1; k<64; ++k)
+            {
+                term           *= q / double(k * k);
+                sum            += term;
+                if (term < sum * 1e-12)
+                    break;
+            }
+            return sum;
+        }
+
+        status_t PolyphaseResampler::init(size_t src_rate, size_t dst_rate)
+        {
+            destroy();
+            if ((src_rate <= 0) || (dst_rate <= 0))
+                return STATUS_BAD_ARGUMENTS;
+
+            // Reduce the ratio
+            size_t a = src_rate, b = dst_rate;
+            while (b != 0)
+            {
+                size_t t        = a % b;
+                a               = b;
+                b               = t;
+            }
+            size_t up       = dst_rate / a;
+            size_t down     = src_rate / a;
+            // The transition band is proportional to the cutoff, the filter is made longer when decimating
+            size_t taps     = TAPS * ((down > up) ? (down + up - 1) / up : 1);
+            if ((up > PHASES_MAX) || (taps > TAPS_MAX))
+                return STATUS_UNSUPPORTED_FORMAT;
+
+            float *ptr      = alloc_aligned<float>(pData, up * taps);
+            if (ptr == NULL)
+                return STATUS_NO_MEM;
+
+            nUp             = up;
+            nDown           = down;
+            nTaps           = taps;
+            vPhases         = ptr;
+
+            // Design the prototype filter at the up-sampled rate and split it into phases.
+            // The sinc is scaled by the cutoff to have the unit gain at the input rate, so the
+            // gain of the prototype is L and each phase, taking every L-th coefficient, has the unit gain.
+            const size_t len    = up * taps;
+            const double fc     = CUTOFF * ((up < down) ? double(up) / double(down) : 1.0);
+            const double center = double(len) * 0.5;
+            const double norm   = 1.0 / bessel_i0(KAISER_BETA);
+
+            for (size_t j=0; j<len; ++j)
+            {
+                double t        = (double(j) - center) / double(up);
+                double x        = M_PI * fc * t;
+                double sinc     = (fabs(x) < 1e-9) ? 1.0 : sin(x) / x;
+                double r        = (double(j) - center) / center;
+                double w        = (fabs(r) < 1.0) ? bessel_i0(KAISER_BETA * sqrt(1.0 - r * r)) * norm : 0.0;
+
+                // Coefficient j belongs to phase (j % up) at tap (j / up), taps are stored reversed
+                size_t phase    = j % up;
+                size_t tap      = j / up;
+                vPhases[phase * taps + (taps - 1 - tap)] = float(fc * sinc * w);
+            }
+
+            return STATUS_OK;
+        }
+
+        size_t PolyphaseResampler::output_length(size_t count) const
+        {
+            return (nDown > 0) ? size_t((wsize_t(count) * nUp + nDown - 1) / nDown) : 0;
+        }
+
+        void PolyphaseResampler::process(float *dst, size_t stride, const float *src, size_t length,
+            ssize_t first, wsize_t offset, size_t count) const
+        {
+            for (size_t n=0; n<count; ++n, dst += stride)
+            {
+                // Output sample is located at input time (offset + n) * M / L
+                wsize_t t       = (offset + n) * nDown;
+                size_t phase    = t % nUp;
+                ssize_t head    = first + ssize_t(t / nUp) - ssize_t(nTaps / 2) + 1;
+                const float *h  = &vPhases[phase * nTaps];
+
+                if ((head >= 0) && ((head + ssize_t(nTaps)) <= ssize_t(length)))
+                {
+                    *dst            = dsp::h_dotp(h, &src[head], nTaps);
+                    continue;
+                }
+
+                // Edges of the signal
+                float sum       = 0.0f;
+                for (size_t k=0; k<nTaps; ++k)
+                {
+                    ssize_t i       = head + ssize_t(k);
+                    if ((i >= 0) && (i < ssize_t(length)))
+                        sum            += h[k] * src[i];
+                }
+                *dst            = sum;
+            }
+        }
+
+        void PolyphaseResampler::dump(dspu::IStateDumper *v) const
+        {
+            v->write("nUp", nUp);
+            v->write("nDown", nDown);
+            v->write("nTaps", nTaps);
+            v->write("vPhases", vPhases);
+            v->write("pData", pData);
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/dsp/dsp.h>
+
+#include <private/plugins/profiler/RingBuffer.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        RingBuffer::RingBuffer()
+        {
+            nChannels   = 0;
+            nCapacity   = 0;
+            nHead       = 0;
+            nTail       = 0;
+            nOverrun    = 0;
+            vData       = NULL;
+            pData       = NULL;
+        }
+
+        RingBuffer::~RingBuffer()
+        {
+            destroy();
+        }
+
+        status_t RingBuffer::init(size_t channels, size_t frames)
+        {
+            if (channels <= 0)
+                return STATUS_BAD_ARGUMENTS;
+
+            size_t capacity = 1;
+            while (capacity < frames)
+                capacity      <<= 1;
+
+            // Keep the memory if it is already allocated
+            if ((channels == nChannels) && (capacity == nCapacity) && (vData != NULL))
+            {
+                clear();
+                return STATUS_OK;
+            }
+
+            destroy();
+            float *ptr      = alloc_aligned<float>(pData, capacity * channels);
+            if (ptr == NULL)
+                return STATUS_NO_MEM;
+
+            nChannels       = channels;
+            nCapacity       = capacity;
+            vData           = ptr;
+            clear();
+
+            return STATUS_OK;
+        }
+
+        void RingBuffer::destroy()
+        {
+            free_aligned(pData);
+            vData       = NULL;
+            nChannels   = 0;
+            nCapacity   = 0;
+            clear();
+        }
+
+        void RingBuffer::clear()
+        {
+            nHead       = 0;
+            nTail       = 0;
+            nOverrun    = 0;
+        }
+
+        size_t RingBuffer::write(const float * const *src, size_t count)
+        {
+            if (vData == NULL)
+                return 0;
+
+            // Only the producer changes the head, the tail may only grow
+            uatomic_t head  = nHead;
+            uatomic_t tail  = atomic_load(&nTail);
+            size_t free     = nCapacity - uatomic_t(head - tail);
+            size_t to_do    = lsp_min(count, free);
+            if (to_do < count)
+                atomic_add(&nOverrun, uatomic_t(count - to_do));
+
+            const size_t mask   = nCapacity - 1;
+            for (size_t i=0; i<to_do; ++i)
+            {
+                float *dst      = &vData[((head + i) & mask) * nChannels];
+                for (size_t ch=0; ch<nChannels; ++ch)
+                    dst[ch]         = src[ch][i];
+            }
+
+            atomic_store(&nHead, uatomic_t(head + to_do));
+            return to_do;
+        }
+
+        size_t RingBuffer::read(float *dst, size_t count)
+        {
+            if (vData == NULL)
+                return 0;
+
+            // Only the consumer changes the tail, the head may only grow
+            uatomic_t tail  = nTail;
+            uatomic_t head  = atomic_load(&nHead);
+            size_t to_do    = lsp_min(count, size_t(uatomic_t(head - tail)));
+
+            // Copy at most two contiguous parts of the buffer
+            const size_t mask   = nCapacity - 1;
+            size_t first    = tail & mask;
+            size_t part     = lsp_min(to_do, nCapacity - first);
+            dsp::copy(dst, &vData[first * nChannels], part * nChannels);
+            if (part < to_do)
+                dsp::copy(&dst[part * nChannels], vData, (to_do - part) * nChannels);
+
+            atomic_store(&nTail, uatomic_t(tail + to_do));
+            return to_do;
+        }
+
+        size_t RingBuffer::available()
+        {
+            return uatomic_t(atomic_load(&nHead) - atomic_load(&nTail));
+        }
+
+        size_t RingBuffer::take_overrun()
+        {
+            return atomic_swap(&nOverrun, uatomic_t(0));
+        }
+
+        void RingBuffer::dump(dspu::IStateDumper *v) const
+        {
+            v->write("nChannels", nChannels);
+            v->write("nCapacity", nCapacity);
+            v->write("nHead", size_t(nHead));
+            v->write("nTail", size_t(nTail));
+            v->write("nOverrun", size_t(nOverrun));
+            v->write("vData", vData);
+            v->write("pData", pData);
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/common/alloc.h>
+
+#include <private/plugins/profiler/ScratchArena.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        ScratchArena::ScratchArena()
+        {
+            nCapacity   = 0;
+            nGrowths    = 0;
+            vData       = NULL;
+            pData       = NULL;
+        }
+
+        ScratchArena::~ScratchArena()
+        {
+            destroy();
+        }
+
+        void ScratchArena::destroy()
+        {
+            free_aligned(pData);
+            nCapacity   = 0;
+            vData       = NULL;
+        }
+
+        float *ScratchArena::reserve(size_t count)
+        {
+            if (count <= nCapacity)
+                return vData;
+
+            // Grow to the next multiple of the alignment to absorb small variations of the request
+            // The previous storage is kept if there is no memory for the new one
+            size_t capacity = align_size(count, size_t(DEFAULT_ALIGN));
+            uint8_t *data   = NULL;
+            float *ptr      = alloc_aligned<float>(data, capacity);
+            if (ptr == NULL)
+                return NULL;
+
+            free_aligned(pData);
+            pData           = data;
+            nCapacity       = capacity;
+            vData           = ptr;
+            ++nGrowths;
+
+            return vData;
+        }
+
+        void ScratchArena::dump(dspu::IStateDumper *v) const
+        {
+            v->write("nCapacity", nCapacity);
+            v->write("nGrowths", nGrowths);
+            v->write("vData", vData);
+            v->write("pData", pData);
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */
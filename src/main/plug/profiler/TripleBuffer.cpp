@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <private/plugins/profiler/TripleBuffer.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        TripleBuffer::TripleBuffer()
+        {
+            reset();
+        }
+
+        TripleBuffer::~TripleBuffer()
+        {
+        }
+
+        void TripleBuffer::reset()
+        {
+            nBack       = 0;
+            nMiddle     = 1;
+            nFront      = 2;
+        }
+
+        void TripleBuffer::publish()
+        {
+            uatomic_t prev  = atomic_swap(&nMiddle, uatomic_t(nBack | F_DIRTY));
+            nBack           = prev & F_INDEX;
+        }
+
+        bool TripleBuffer::fetch()
+        {
+            if (!(atomic_load(&nMiddle) & F_DIRTY))
+                return false;
+
+            uatomic_t prev  = atomic_swap(&nMiddle, nFront);
+            nFront          = prev & F_INDEX;
+            return true;
+        }
+
+        bool TripleBuffer::pending()
+        {
+            return atomic_load(&nMiddle) & F_DIRTY;
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */
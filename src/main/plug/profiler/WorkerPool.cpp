@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-profiler
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-profiler is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-profiler is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-profiler. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/common/debug.h>
+#include <lsp-plug.in/stdlib/math.h>
+
+#include <private/plugins/profiler/WorkerPool.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        WorkerPool::Worker::Worker(WorkerPool *pool, size_t index)
+        {
+            pPool       = pool;
+            nIndex      = index;
+        }
+
+        WorkerPool::Worker::~Worker()
+        {
+            pPool       = NULL;
+        }
+
+        status_t WorkerPool::Worker::run()
+        {
+            while (!atomic_load(&pPool->nShutdown))
+            {
+                // Execute everything that can be taken, then poll for new submissions.
+                // The submitter does not wake up threads, the semaphore is posted only on shutdown
+                if (!pPool->process(nIndex))
+                    pPool->sShutdown.wait(POLL_TIME);
+            }
+
+            return STATUS_OK;
+        }
+
+        //---------------------------------------------------------------------
+        WorkerPool::WorkerPool()
+        {
+            nThreads    = 0;
+            nNext       = 0;
+            nPending    = 0;
+            nShutdown   = 0;
+            vWorkers    = NULL;
+            vDeques     = NULL;
+        }
+
+        WorkerPool::~WorkerPool()
+        {
+            shutdown();
+        }
+
+        status_t WorkerPool::start(size_t threads)
+        {
+            if (nThreads > 0)
+                return STATUS_BAD_STATE;
+            if (threads <= 0)
+                threads     = ipc::Thread::system_cores();
+            threads     = lsp_max(threads, size_t(1));
+
+            // The arrays are sized for the number of threads
+            vWorkers    = new Worker *[threads];
+            vDeques     = new deque_t[threads];
+            if ((vWorkers == NULL) || (vDeques == NULL))
+            {
+                shutdown();
+                return STATUS_NO_MEM;
+            }
+            for (size_t i=0; i<threads; ++i)
+            {
+                deque_t *d  = &vDeques[i];
+                d->nHead    = 0;
+                d->nCount   = 0;
+                for (size_t j=0; j<DEQUE_SIZE; ++j)
+                    d->vTasks[j]    = NULL;
+                vWorkers[i] = NULL;
+            }
+
+            atomic_store(&nShutdown, uatomic_t(0));
+            atomic_store(&nPending, uatomic_t(0));
+            for (size_t i=0; i<threads; ++i)
+            {
+                Worker *w   = new Worker(this, i);
+                if (w == NULL)
+                    break;
+                if (w->start() != STATUS_OK)
+                {
+                    delete w;
+                    break;
+                }
+                vWorkers[nThreads++]    = w;
+            }
+            lsp_trace("Started %d worker threads", int(nThreads));
+
+            if (nThreads <= 0)
+            {
+                shutdown();
+                return STATUS_UNKNOWN_ERR;
+            }
+
+            return STATUS_OK;
+        }
+
+        void WorkerPool::cancel(deque_t *d)
+        {
+            // Tasks that have not been started are returned to the idle state, so the owner
+            // does not wait for them and may submit them again
+            for ( ; d->nCount > 0; --d->nCount)
+            {
+                ipc::ITask *task    = d->vTasks[d->nHead];
+                d->vTasks[d->nHead] = NULL;
+                d->nHead            = (d->nHead + 1) % DEQUE_SIZE;
+                change_task_state(task, ipc::ITask::TS_IDLE);
+            }
+            d->nHead            = 0;
+        }
+
+        void WorkerPool::shutdown()
+        {
+            size_t threads  = nThreads;
+
+            atomic_store(&nShutdown, uatomic_t(1));
+            for (size_t i=0; i<threads; ++i)
+                sShutdown.post();
+            for (size_t i=0; i<threads; ++i)
+            {
+                vWorkers[i]->join();
+                delete vWorkers[i];
+                vWorkers[i]     = NULL;
+            }
+            nThreads    = 0;
+
+            // All threads are stopped, the deques are accessed exclusively
+            if (vDeques != NULL)
+            {
+                for (size_t i=0; i<threads; ++i)
+                    cancel(&vDeques[i]);
+                delete [] vDeques;
+                vDeques     = NULL;
+            }
+            if (vWorkers != NULL)
+            {
+                delete [] vWorkers;
+                vWorkers    = NULL;
+            }
+            atomic_store(&nPending, uatomic_t(0));
+        }
+
+        bool WorkerPool::submit(ipc::ITask *task)
+        {
+            if ((nThreads <= 0) || (atomic_load(&nShutdown)) || (!task->idle()))
+                return false;
+
+            // Try each deque starting from the next one, skip deques that are busy or full
+            size_t first    = atomic_add(&nNext, uatomic_t(1));
+            for (size_t i=0; i<nThreads; ++i)
+            {
+                deque_t *d      = &vDeques[(first + i) % nThreads];
+                if (!d->sLock.try_lock())
+                    continue;
+
+                bool queued     = d->nCount < DEQUE_SIZE;
+                if (queued)
+                {
+                    change_task_state(task, ipc::ITask::TS_SUBMITTED);
+                    d->vTasks[(d->nHead + d->nCount) % DEQUE_SIZE] = task;
+                    ++d->nCount;
+                    atomic_add(&nPending, uatomic_t(1));
+                }
+                d->sLock.unlock();
+
+                if (queued)
+                    return true;
+            }
+
+            return false;
+        }
+
+        ipc::ITask *WorkerPool::take(size_t index)
+        {
+            // Nothing is queued, the deques are not touched at all
+            if (atomic_load(&nPending) <= 0)
+                return NULL;
+
+            ipc::ITask *task    = NULL;
+
+            // The newest task of the own deque
+            deque_t *d          = &vDeques[index];
+            if (d->sLock.try_lock())
+            {
+                if (d->nCount > 0)
+                {
+                    --d->nCount;
+                    task                = d->vTasks[(d->nHead + d->nCount) % DEQUE_SIZE];
+                }
+                d->sLock.unlock();
+            }
+
+            // The oldest task of other deques, the busy deques are not waited for
+            for (size_t i=1; (task == NULL) && (i<nThreads); ++i)
+            {
+                d                   = &vDeques[(index + i) % nThreads];
+                if (!d->sLock.try_lock())
+                    continue;
+                if (d->nCount > 0)
+                {
+                    task                = d->vTasks[d->nHead];
+                    d->nHead            = (d->nHead + 1) % DEQUE_SIZE;
+                    --d->nCount;
+                }
+                d->sLock.unlock();
+            }
+
+            if (task != NULL)
+                atomic_add(&nPending, uatomic_t(-1));
+
+            return task;
+        }
+
+        bool WorkerPool::process(size_t index)
+        {
+            ipc::ITask *task    = take(index);
+            if (task == NULL)
+                return atomic_load(&nPending) > 0;
+
+            run_task(task);
+            return true;
+        }
+
+        void WorkerPool::dump(dspu::IStateDumper *v) const
+        {
+            v->write("nThreads", nThreads);
+            v->write("nNext", nNext);
+            v->write("nPending", nPending);
+            v->write("nShutdown", nShutdown);
+            v->write("vWorkers", vWorkers);
+            v->begin_array("vDeques", vDeques, nThreads);
+            {
+                for (size_t i=0; i<nThreads; ++i)
+                {
+                    const deque_t *d    = &vDeques[i];
+                    v->begin_object(d, sizeof(deque_t));
+                    {
+                        v->write("nHead", d->nHead);
+                        v->write("nCount", d->nCount);
+                    }
+                    v->end_object();
+                }
+            }
+            v->end_array();
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */